@@ -164,8 +164,10 @@ if (downloadRaylib) then
     
         includedirs { "../src" }
         includedirs { "../include" }
+        includedirs { "../rules" }
+        includedirs { "../engine" }
 
-        links {"raylib"}
+        links {"ChessEngine", "ChessRules", "raylib"}
 
         cdialect "C17"
         cppdialect "C++17"
@@ -178,7 +180,7 @@ if (downloadRaylib) then
 
         filter "action:vs*"
             defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS"}
-            dependson {"raylib"}
+            dependson {"ChessEngine", "ChessRules", "raylib"}
             links {"raylib.lib"}
             characterset ("Unicode")
             buildoptions { "/Zc:__cplusplus" }
@@ -227,3 +229,140 @@ if (downloadRaylib) then
             compileas "Objective-C"
 
         filter{}
+
+
+    project "ChessRules"
+        kind "StaticLib"
+        location "build_files/"
+
+        language "C++"
+        cppdialect "C++17"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            buildoptions { "/Zc:__cplusplus" }
+        filter{}
+
+        vpaths
+        {
+            ["Header Files/*"] = { "../rules/**.h"},
+            ["Source Files/*"] = { "../rules/**.cpp"},
+        }
+        files {"../rules/**.h", "../rules/**.cpp"}
+        includedirs { "../rules" }
+
+
+    project "ChessEngine"
+        kind "StaticLib"
+        location "build_files/"
+
+        language "C++"
+        cppdialect "C++17"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            dependson {"ChessRules"}
+            buildoptions { "/Zc:__cplusplus" }
+        filter{}
+
+        vpaths
+        {
+            ["Header Files/*"] = { "../engine/**.h"},
+            ["Source Files/*"] = { "../engine/**.cpp"},
+        }
+        files {"../engine/**.h", "../engine/**.cpp"}
+        includedirs { "../rules", "../engine" }
+
+
+    project "perft"
+        kind "ConsoleApp"
+        location "build_files/"
+
+        language "C++"
+        cppdialect "C++17"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            dependson {"ChessRules"}
+            buildoptions { "/Zc:__cplusplus" }
+        filter{}
+
+        files {"../tools/Perft.cpp"}
+        includedirs { "../rules" }
+        links {"ChessRules"}
+
+        filter "system:linux"
+            links {"pthread"}
+        filter{}
+
+
+    project "bench"
+        kind "ConsoleApp"
+        location "build_files/"
+
+        language "C++"
+        cppdialect "C++17"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            dependson {"ChessEngine", "ChessRules"}
+            buildoptions { "/Zc:__cplusplus" }
+        filter{}
+
+        files {"../tools/Bench.cpp"}
+        includedirs { "../rules", "../engine" }
+        links {"ChessEngine", "ChessRules"}
+
+        filter "system:linux"
+            links {"pthread"}
+        filter{}
+
+
+    project "tune"
+        kind "ConsoleApp"
+        location "build_files/"
+
+        language "C++"
+        cppdialect "C++17"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            dependson {"ChessEngine", "ChessRules"}
+            buildoptions { "/Zc:__cplusplus" }
+        filter{}
+
+        files {"../tools/Tune.cpp"}
+        includedirs { "../rules", "../engine" }
+        links {"ChessEngine", "ChessRules"}
+
+        filter "system:linux"
+            links {"pthread"}
+        filter{}
+
+
+    project "uci"
+        kind "ConsoleApp"
+        location "build_files/"
+
+        language "C++"
+        cppdialect "C++17"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            dependson {"ChessEngine", "ChessRules"}
+            buildoptions { "/Zc:__cplusplus" }
+        filter{}
+
+        files {"../tools/Uci.cpp"}
+        includedirs { "../rules", "../engine" }
+        links {"ChessEngine", "ChessRules"}
+
+        filter "system:linux"
+            links {"pthread"}
+        filter{}
@@ -0,0 +1,134 @@
+#include "Engine.h"
+
+Engine::Engine() : thinking(false), finished(false)
+{
+    SetThreads(1);
+}
+
+Engine::~Engine()
+{
+    Stop();
+}
+
+void Engine::SetThreads(int count)
+{
+    Stop();
+    if (count < 1)
+        count = 1;
+    searches.clear();
+    for (int i = 0; i < count; i++)
+    {
+        searches.push_back(std::unique_ptr<Search>(new Search()));
+        searches[i]->SetTable(&table);
+        searches[i]->SetThreadIndex(i);
+        searches[i]->SetOptions(options);
+    }
+    searches[0]->SetInfoCallback(infoCallback);
+}
+
+void Engine::SetOptions(const SearchOptions& searchOptions)
+{
+    Stop();
+    options = searchOptions;
+    for (auto& search : searches)
+        search->SetOptions(options);
+}
+
+// Only the main thread reports; the callback runs on the search thread.
+void Engine::SetInfoCallback(const InfoCallback& callback)
+{
+    Stop();
+    infoCallback = callback;
+    searches[0]->SetInfoCallback(infoCallback);
+}
+
+bool Engine::SetHashSize(size_t megabytes)
+{
+    Stop();
+    return table.Resize(megabytes);
+}
+
+void Engine::NewGame()
+{
+    Stop();
+    table.Clear();
+}
+
+// Helpers ignore the limits and run until the main search is done, so that
+// a deeper helper never holds up the move.
+void Engine::RunThreads(const Board& board, const PositionHistory& history, const SearchLimits& limits)
+{
+    std::vector<std::thread> helpers;
+    std::vector<SearchResult> helperResults(searches.size());
+    for (size_t i = 1; i < searches.size(); i++)
+    {
+        helpers.emplace_back([this, i, &board, &history, &helperResults]() {
+            helperResults[i] = searches[i]->Run(board, history, SearchLimits());
+        });
+    }
+
+    SearchResult mainResult = searches[0]->Run(board, history, limits);
+
+    for (size_t i = 1; i < searches.size(); i++)
+        searches[i]->Stop();
+    for (std::thread& helper : helpers)
+        helper.join();
+    for (size_t i = 1; i < searches.size(); i++)
+    {
+        mainResult.nodes += helperResults[i].nodes;
+        mainResult.tableStats += helperResults[i].tableStats;
+        mainResult.pawnStats += helperResults[i].pawnStats;
+    }
+
+    result = mainResult;
+}
+
+void Engine::Start(const Board& board, const PositionHistory& history, const SearchLimits& limits)
+{
+    Stop();
+    for (auto& search : searches)
+        search->ClearStop();
+    table.NewSearch();
+    finished = false;
+    thinking = true;
+    worker = std::thread([this, board, history, limits]() {
+        RunThreads(board, history, limits);
+        finished = true;
+        thinking = false;
+    });
+}
+
+// Cancels a running search and discards whatever it found.
+void Engine::Stop()
+{
+    if (worker.joinable())
+    {
+        for (auto& search : searches)
+            search->Stop();
+        worker.join();
+    }
+    thinking = false;
+    finished = false;
+}
+
+// Ends a running search early but keeps its result for TakeResult. Safe to
+// call from any thread while another one waits on the search.
+void Engine::RequestStop()
+{
+    for (auto& search : searches)
+        search->Stop();
+}
+
+SearchResult Engine::SearchBlocking(const Board& board, const PositionHistory& history, const SearchLimits& limits)
+{
+    Start(board, history, limits);
+    return TakeResult();
+}
+
+SearchResult Engine::TakeResult()
+{
+    if (worker.joinable())
+        worker.join();
+    finished = false;
+    return result;
+}
@@ -0,0 +1,55 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "Search.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Runs a Lazy SMP search on worker threads so the caller can keep drawing
+// frames. Every thread searches the same root and shares one transposition
+// table; the main thread's result is the one played. Start copies the
+// position, so the caller's board may change meanwhile.
+class Engine {
+private:
+    TranspositionTable table;
+    std::vector<std::unique_ptr<Search>> searches;
+    std::thread worker;
+    std::atomic<bool> thinking;
+    std::atomic<bool> finished;
+    SearchResult result;
+    SearchOptions options;
+    InfoCallback infoCallback;
+
+    void RunThreads(const Board& board, const PositionHistory& history, const SearchLimits& limits);
+
+public:
+    Engine();
+    ~Engine();
+
+    Engine(const Engine&) = delete;
+    Engine& operator=(const Engine&) = delete;
+
+    void SetThreads(int count);
+    int GetThreads() const { return (int)searches.size(); }
+    bool SetHashSize(size_t megabytes);
+    size_t GetHashSizeBytes() const { return table.GetSizeBytes(); }
+    int GetHashFillPermille() const { return table.GetFillPermille(); }
+    void SetOptions(const SearchOptions& searchOptions);
+    const SearchOptions& GetOptions() const { return options; }
+    void SetInfoCallback(const InfoCallback& callback);
+    void NewGame();
+
+    void Start(const Board& board, const PositionHistory& history, const SearchLimits& limits);
+    void Stop();
+    void RequestStop();
+    SearchResult SearchBlocking(const Board& board, const PositionHistory& history, const SearchLimits& limits);
+
+    bool IsThinking() const { return thinking; }
+    bool HasResult() const { return finished; }
+    SearchResult TakeResult();
+};
+
+#endif
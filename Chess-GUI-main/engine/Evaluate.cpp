@@ -0,0 +1,99 @@
+#include "Evaluate.h"
+#include "Nnue.h"
+#include "PieceSquare.h"
+
+namespace {
+
+const Bitboard FILE_A = 0x0101010101010101ULL;
+
+Bitboard FileBB(int x) { return FILE_A << x; }
+
+Bitboard AdjacentFiles(int x)
+{
+    return (x > 0 ? FileBB(x - 1) : 0) | (x < 7 ? FileBB(x + 1) : 0);
+}
+
+// Rows in front of a pawn on row y, towards the side's promotion rank.
+Bitboard RowsAhead(int y, bool isWhite)
+{
+    if (isWhite)
+        return (1ULL << (y * 8)) - 1;
+    return y < 7 ? ~((1ULL << ((y + 1) * 8)) - 1) : 0;
+}
+
+}
+
+int Evaluate(const Board& board)
+{
+    if (IsNetworkLoaded())
+        return GetNetwork().Evaluate(board);
+    return EvaluateClassical(board);
+}
+
+PawnFeatures CountPawnFeatures(const Board& board, bool isWhite)
+{
+    Bitboard ours = board.GetPieces(PieceType::PAWN, isWhite);
+    Bitboard theirs = board.GetPieces(PieceType::PAWN, !isWhite);
+    PawnFeatures features;
+
+    for (int x = 0; x < 8; x++)
+    {
+        int count = PopCount(ours & FileBB(x));
+        if (count == 0)
+            continue;
+        features.doubled += count - 1;
+        if ((ours & AdjacentFiles(x)) == 0)
+            features.isolated += count;
+    }
+
+    for (Bitboard pawns = ours; pawns; )
+    {
+        int square = PopLsb(pawns);
+        int x = SquareX(square);
+        int y = SquareY(square);
+        if ((theirs & (FileBB(x) | AdjacentFiles(x)) & RowsAhead(y, isWhite)) == 0)
+            features.passed[isWhite ? 7 - y : y]++;
+    }
+    return features;
+}
+
+PawnEntry EvaluatePawns(const Board& board)
+{
+    int midgame = 0;
+    int endgame = 0;
+    for (int side = 0; side < 2; side++)
+    {
+        PawnFeatures features = CountPawnFeatures(board, side == 0);
+        int sign = side == 0 ? 1 : -1;
+        midgame += sign * (features.doubled * DOUBLED_MIDGAME + features.isolated * ISOLATED_MIDGAME);
+        endgame += sign * (features.doubled * DOUBLED_ENDGAME + features.isolated * ISOLATED_ENDGAME);
+        for (int rank = 0; rank < 8; rank++)
+        {
+            midgame += sign * features.passed[rank] * PASSED_MIDGAME[rank];
+            endgame += sign * features.passed[rank] * PASSED_ENDGAME[rank];
+        }
+    }
+
+    PawnEntry entry;
+    entry.key = board.GetPawnKey();
+    entry.midgame = (int16_t)midgame;
+    entry.endgame = (int16_t)endgame;
+    return entry;
+}
+
+int EvaluateClassical(const Board& board, PawnTable* pawnTable)
+{
+    PawnEntry pawns;
+    if (!pawnTable || !pawnTable->Probe(board.GetPawnKey(), pawns))
+    {
+        pawns = EvaluatePawns(board);
+        if (pawnTable)
+            pawnTable->Store(pawns);
+    }
+
+    int phase = board.GetPhase() < MAX_PHASE ? board.GetPhase() : MAX_PHASE;
+    int midgame = board.GetMidgameScore() + pawns.midgame;
+    int endgame = board.GetEndgameScore() + pawns.endgame;
+    int score = (midgame * phase + endgame * (MAX_PHASE - phase)) / MAX_PHASE;
+    return board.IsWhiteToMove() ? score : -score;
+}
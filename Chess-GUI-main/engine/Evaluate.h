@@ -0,0 +1,42 @@
+#ifndef EVALUATE_H
+#define EVALUATE_H
+
+#include "Board.h"
+#include "PawnTable.h"
+
+const int PIECE_VALUES[NUM_PIECE_TYPES] = {100, 500, 320, 330, 900, 0};
+
+// Static score in centipawns from the side to move's point of view. This is
+// the network's score once one is loaded, and the classical one otherwise:
+// the board's middlegame and endgame totals plus pawn structure, blended by
+// how much material is left. PIECE_VALUES stay the simpler scale used for
+// exchanges and ordering.
+int Evaluate(const Board& board);
+
+// A search passes its pawn table so that the pawn terms are only worked out
+// once per pawn structure.
+int EvaluateClassical(const Board& board, PawnTable* pawnTable = nullptr);
+
+// Passed pawn bonuses by rank counted from the pawn's own side, and the
+// penalties per doubled or isolated pawn.
+const int PASSED_MIDGAME[8] = {0, 5, 10, 15, 25, 40, 60, 0};
+const int PASSED_ENDGAME[8] = {0, 10, 20, 35, 60, 100, 150, 0};
+const int DOUBLED_MIDGAME = -10;
+const int DOUBLED_ENDGAME = -20;
+const int ISOLATED_MIDGAME = -10;
+const int ISOLATED_ENDGAME = -15;
+
+// How often each pawn term applies to one side. EvaluatePawns weighs these
+// by the constants above; the tuner uses them as its features.
+struct PawnFeatures {
+    int doubled = 0;
+    int isolated = 0;
+    int passed[8] = {};
+};
+
+PawnFeatures CountPawnFeatures(const Board& board, bool isWhite);
+
+// Passed, isolated and doubled pawns, white minus black.
+PawnEntry EvaluatePawns(const Board& board);
+
+#endif
@@ -0,0 +1,199 @@
+#include "MovePicker.h"
+#include "Evaluate.h"
+#include "Rules.h"
+#include "See.h"
+#include <algorithm>
+#include <cstring>
+
+static const int HISTORY_LIMIT = 1 << 14;
+
+void MoveOrderTables::Clear()
+{
+    for (int ply = 0; ply < MAX_PLY; ply++)
+        killers[ply][0] = killers[ply][1] = BoardMove();
+    for (int from = 0; from < NUM_SQUARES; from++)
+    {
+        for (int to = 0; to < NUM_SQUARES; to++)
+            counterMoves[from][to] = BoardMove();
+    }
+    memset(history, 0, sizeof(history));
+}
+
+BoardMove MoveOrderTables::GetCounterMove(const BoardMove& previous) const
+{
+    if (previous.IsNull())
+        return BoardMove();
+    return counterMoves[previous.GetFrom()][previous.GetTo()];
+}
+
+// Called when a quiet move causes a beta cutoff. The move is rewarded in
+// proportion to the depth it was searched at, the quiet moves tried before
+// it are penalised, and the scores decay as they approach the limit.
+void MoveOrderTables::UpdateQuiet(const Board& board, int ply, int depth, const BoardMove& best,
+                                  const BoardMove& previous, const BoardMove* tried, int triedCount)
+{
+    if (ply < MAX_PLY && killers[ply][0] != best)
+    {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = best;
+    }
+    if (!previous.IsNull())
+        counterMoves[previous.GetFrom()][previous.GetTo()] = best;
+
+    int side = board.IsWhiteToMove() ? 0 : 1;
+    int bonus = depth * depth > 400 ? 400 : depth * depth;
+    for (int i = 0; i < triedCount; i++)
+    {
+        int& entry = history[side][tried[i].GetFrom()][tried[i].GetTo()];
+        int delta = tried[i] == best ? bonus : -bonus;
+        entry += delta - entry * (delta < 0 ? -delta : delta) / HISTORY_LIMIT;
+    }
+}
+
+MovePicker::MovePicker(const Board& position, const MoveOrderTables& orderTables, const BoardMove& ttMove, int ply,
+    const BoardMove& previous)
+    : board(position), tables(orderTables), noisyOnly(false), hashMove(ttMove), stage(STAGE_HASH), current(0), badCurrent(0)
+{
+    killers[0] = ply < MAX_PLY ? tables.GetKiller(ply, 0) : BoardMove();
+    killers[1] = ply < MAX_PLY ? tables.GetKiller(ply, 1) : BoardMove();
+    counterMove = tables.GetCounterMove(previous);
+}
+
+MovePicker::MovePicker(const Board& position, const MoveOrderTables& orderTables)
+    : board(position), tables(orderTables), noisyOnly(true), stage(STAGE_GENERATE_NOISY), current(0), badCurrent(0)
+{
+}
+
+// Moves handed out before the generated stages, which those stages skip.
+bool MovePicker::IsSpecial(const BoardMove& move) const
+{
+    return move == hashMove || move == killers[0] || move == killers[1] || move == counterMove;
+}
+
+// A killer or countermove comes from another position, so it has to be a
+// legal quiet move here before it is tried.
+bool MovePicker::TrySpecial(const BoardMove& move) const
+{
+    return !move.IsNull() && move != hashMove && !move.IsCapture() && !move.IsPromotion() && IsLegalMove(board, move);
+}
+
+// Selection sort, one step at a time: most nodes cut off after a move or
+// two, so sorting the whole list up front would be wasted.
+int MovePicker::PickBest()
+{
+    int best = current;
+    for (int i = current + 1; i < moves.Size(); i++)
+    {
+        if (scores[i] > scores[best])
+            best = i;
+    }
+    if (best != current)
+    {
+        std::swap(moves[best], moves[current]);
+        std::swap(scores[best], scores[current]);
+    }
+    return current++;
+}
+
+BoardMove MovePicker::Next()
+{
+    switch (stage)
+    {
+    case STAGE_HASH:
+        stage = STAGE_GENERATE_NOISY;
+        if (!hashMove.IsNull() && IsLegalMove(board, hashMove))
+            return hashMove;
+        hashMove = BoardMove();
+        // fall through
+
+    case STAGE_GENERATE_NOISY:
+        moves.Clear();
+        GenerateNoisyMoves(board, moves);
+        for (int i = 0; i < moves.Size(); i++)
+        {
+            const BoardMove& move = moves[i];
+            int victim = 0;
+            if (move.IsEnPassant())
+                victim = PIECE_VALUES[(int)PieceType::PAWN];
+            else if (move.IsCapture())
+                victim = PIECE_VALUES[(int)board.GetTypeAt(move.GetTo())];
+            if (move.IsPromotion())
+                victim += PIECE_VALUES[(int)move.GetPromotion()];
+            scores[i] = victim * 10 - PIECE_VALUES[(int)board.GetTypeAt(move.GetFrom())];
+        }
+        current = 0;
+        stage = STAGE_GOOD_NOISY;
+        // fall through
+
+    case STAGE_GOOD_NOISY:
+        while (current < moves.Size())
+        {
+            BoardMove move = moves[PickBest()];
+            if (move == hashMove)
+                continue;
+            // Underpromotions and captures that lose material wait until
+            // after the quiet moves.
+            bool underpromotion = move.IsPromotion() && move.GetPromotion() != PieceType::QUEEN;
+            if (underpromotion || !SeeAtLeast(board, move, 0))
+            {
+                badNoisy.Add(move);
+                continue;
+            }
+            return move;
+        }
+        if (noisyOnly)
+        {
+            stage = STAGE_DONE;
+            break;
+        }
+        stage = STAGE_KILLER_1;
+        // fall through
+
+    case STAGE_KILLER_1:
+        stage = STAGE_KILLER_2;
+        if (TrySpecial(killers[0]))
+            return killers[0];
+        // fall through
+
+    case STAGE_KILLER_2:
+        stage = STAGE_COUNTER;
+        if (killers[1] != killers[0] && TrySpecial(killers[1]))
+            return killers[1];
+        // fall through
+
+    case STAGE_COUNTER:
+        stage = STAGE_GENERATE_QUIET;
+        if (counterMove != killers[0] && counterMove != killers[1] && TrySpecial(counterMove))
+            return counterMove;
+        // fall through
+
+    case STAGE_GENERATE_QUIET:
+        moves.Clear();
+        GenerateQuietMoves(board, moves);
+        for (int i = 0; i < moves.Size(); i++)
+            scores[i] = tables.GetHistory(board.IsWhiteToMove(), moves[i]);
+        current = 0;
+        stage = STAGE_QUIET;
+        // fall through
+
+    case STAGE_QUIET:
+        while (current < moves.Size())
+        {
+            BoardMove move = moves[PickBest()];
+            if (!IsSpecial(move))
+                return move;
+        }
+        stage = STAGE_BAD_NOISY;
+        // fall through
+
+    case STAGE_BAD_NOISY:
+        if (badCurrent < badNoisy.Size())
+            return badNoisy[badCurrent++];
+        stage = STAGE_DONE;
+        // fall through
+
+    case STAGE_DONE:
+        break;
+    }
+    return BoardMove();
+}
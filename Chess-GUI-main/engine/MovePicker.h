@@ -0,0 +1,77 @@
+#ifndef MOVE_PICKER_H
+#define MOVE_PICKER_H
+
+#include "Board.h"
+#include "Score.h"
+
+// What a search has learned about quiet moves: two killers per ply, the
+// reply that refuted each previous move, and a history score per side,
+// from and to square. Each search thread keeps its own.
+class MoveOrderTables {
+private:
+    BoardMove killers[MAX_PLY][2];
+    BoardMove counterMoves[NUM_SQUARES][NUM_SQUARES];
+    int history[2][NUM_SQUARES][NUM_SQUARES];
+
+public:
+    MoveOrderTables() { Clear(); }
+
+    void Clear();
+    void UpdateQuiet(const Board& board, int ply, int depth, const BoardMove& best, const BoardMove& previous,
+                     const BoardMove* tried, int triedCount);
+
+    BoardMove GetKiller(int ply, int slot) const { return killers[ply][slot]; }
+    BoardMove GetCounterMove(const BoardMove& previous) const;
+    int GetHistory(bool white, const BoardMove& move) const { return history[white ? 0 : 1][move.GetFrom()][move.GetTo()]; }
+};
+
+// Hands out a node's moves best-first, one stage at a time, so a cutoff
+// early on skips generating and sorting the rest:
+//   hash move, captures and promotions that win or trade material
+//   (MVV-LVA, checked with SEE), killers, the countermove, quiet moves by
+//   history, and finally the captures SEE says lose material.
+// Next returns a null move when there are none left.
+class MovePicker {
+private:
+    enum Stage {
+        STAGE_HASH,
+        STAGE_GENERATE_NOISY,
+        STAGE_GOOD_NOISY,
+        STAGE_KILLER_1,
+        STAGE_KILLER_2,
+        STAGE_COUNTER,
+        STAGE_GENERATE_QUIET,
+        STAGE_QUIET,
+        STAGE_BAD_NOISY,
+        STAGE_DONE
+    };
+
+    const Board& board;
+    const MoveOrderTables& tables;
+    bool noisyOnly;
+    BoardMove hashMove;
+    BoardMove killers[2];
+    BoardMove counterMove;
+    Stage stage;
+
+    MoveList moves;
+    int scores[MAX_MOVES];
+    int current;
+    MoveList badNoisy;
+    int badCurrent;
+
+    bool IsSpecial(const BoardMove& move) const;
+    bool TrySpecial(const BoardMove& move) const;
+    int PickBest();
+
+public:
+    MovePicker(const Board& position, const MoveOrderTables& orderTables, const BoardMove& ttMove, int ply,
+        const BoardMove& previous);
+    // Quiescence search: only the captures and queen promotions that do not
+    // lose material.
+    MovePicker(const Board& position, const MoveOrderTables& orderTables);
+
+    BoardMove Next();
+};
+
+#endif
@@ -0,0 +1,353 @@
+#include "Nnue.h"
+#include "Score.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define NNUE_X86
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define NNUE_X86
+#endif
+
+#if defined(__GNUC__) && defined(NNUE_X86)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#else
+#define TARGET_AVX2
+#define TARGET_SSE41
+#endif
+
+namespace {
+
+const uint32_t NNUE_MAGIC = 0x45554E4E;
+const uint32_t NNUE_VERSION = 1;
+
+Network network;
+bool networkLoaded = false;
+
+int FeatureIndex(int perspective, bool pieceWhite, PieceType type, int square)
+{
+    int relativeSide = (pieceWhite ? 0 : 1) == perspective ? 0 : 1;
+    int relativeSquare = perspective == 0 ? square : square ^ 56;
+    return (relativeSide * NUM_PIECE_TYPES + (int)type) * NUM_SQUARES + relativeSquare;
+}
+
+// Kernels: child = parent + added columns - removed columns, and the
+// clipped dot product of both halves with the output weights.
+typedef void (*UpdateKernel)(int16_t* out, const int16_t* in, const int16_t* const* added, int addCount,
+                             const int16_t* const* removed, int removeCount);
+typedef int32_t (*OutputKernel)(const int16_t* us, const int16_t* them, const int16_t* weights);
+
+void UpdateScalar(int16_t* out, const int16_t* in, const int16_t* const* added, int addCount,
+                  const int16_t* const* removed, int removeCount)
+{
+    for (int i = 0; i < NNUE_HIDDEN; i++)
+    {
+        int value = in[i];
+        for (int a = 0; a < addCount; a++)
+            value += added[a][i];
+        for (int r = 0; r < removeCount; r++)
+            value -= removed[r][i];
+        out[i] = (int16_t)value;
+    }
+}
+
+int32_t OutputScalar(const int16_t* us, const int16_t* them, const int16_t* weights)
+{
+    int32_t sum = 0;
+    for (int i = 0; i < NNUE_HIDDEN; i++)
+    {
+        int a = us[i] < 0 ? 0 : (us[i] > NNUE_QA ? NNUE_QA : us[i]);
+        int b = them[i] < 0 ? 0 : (them[i] > NNUE_QA ? NNUE_QA : them[i]);
+        sum += a * weights[i] + b * weights[NNUE_HIDDEN + i];
+    }
+    return sum;
+}
+
+#if defined(NNUE_X86)
+TARGET_SSE41 void UpdateSse41(int16_t* out, const int16_t* in, const int16_t* const* added, int addCount,
+                              const int16_t* const* removed, int removeCount)
+{
+    for (int i = 0; i < NNUE_HIDDEN; i += 8)
+    {
+        __m128i value = _mm_load_si128((const __m128i*)(in + i));
+        for (int a = 0; a < addCount; a++)
+            value = _mm_add_epi16(value, _mm_load_si128((const __m128i*)(added[a] + i)));
+        for (int r = 0; r < removeCount; r++)
+            value = _mm_sub_epi16(value, _mm_load_si128((const __m128i*)(removed[r] + i)));
+        _mm_store_si128((__m128i*)(out + i), value);
+    }
+}
+
+TARGET_SSE41 int32_t OutputSse41(const int16_t* us, const int16_t* them, const int16_t* weights)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ceiling = _mm_set1_epi16(NNUE_QA);
+    __m128i sum = _mm_setzero_si128();
+    for (int i = 0; i < NNUE_HIDDEN; i += 8)
+    {
+        __m128i a = _mm_min_epi16(_mm_max_epi16(_mm_load_si128((const __m128i*)(us + i)), zero), ceiling);
+        __m128i b = _mm_min_epi16(_mm_max_epi16(_mm_load_si128((const __m128i*)(them + i)), zero), ceiling);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(a, _mm_load_si128((const __m128i*)(weights + i))));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(b, _mm_load_si128((const __m128i*)(weights + NNUE_HIDDEN + i))));
+    }
+    return _mm_extract_epi32(sum, 0) + _mm_extract_epi32(sum, 1) + _mm_extract_epi32(sum, 2) + _mm_extract_epi32(sum, 3);
+}
+
+TARGET_AVX2 void UpdateAvx2(int16_t* out, const int16_t* in, const int16_t* const* added, int addCount,
+                            const int16_t* const* removed, int removeCount)
+{
+    for (int i = 0; i < NNUE_HIDDEN; i += 16)
+    {
+        __m256i value = _mm256_load_si256((const __m256i*)(in + i));
+        for (int a = 0; a < addCount; a++)
+            value = _mm256_add_epi16(value, _mm256_load_si256((const __m256i*)(added[a] + i)));
+        for (int r = 0; r < removeCount; r++)
+            value = _mm256_sub_epi16(value, _mm256_load_si256((const __m256i*)(removed[r] + i)));
+        _mm256_store_si256((__m256i*)(out + i), value);
+    }
+}
+
+TARGET_AVX2 int32_t OutputAvx2(const int16_t* us, const int16_t* them, const int16_t* weights)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ceiling = _mm256_set1_epi16(NNUE_QA);
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < NNUE_HIDDEN; i += 16)
+    {
+        __m256i a = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256((const __m256i*)(us + i)), zero), ceiling);
+        __m256i b = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256((const __m256i*)(them + i)), zero), ceiling);
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a, _mm256_load_si256((const __m256i*)(weights + i))));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(b, _mm256_load_si256((const __m256i*)(weights + NNUE_HIDDEN + i))));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+    return _mm_cvtsi128_si32(half);
+}
+#endif
+
+SimdLevel DetectSimd()
+{
+#if defined(_MSC_VER) && defined(NNUE_X86)
+    int info[4];
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    bool osAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+    __cpuidex(info, 7, 0);
+    if (osAvx && (info[1] & (1 << 5)))
+        return SIMD_AVX2;
+    return sse41 ? SIMD_SSE41 : SIMD_SCALAR;
+#elif defined(__GNUC__) && defined(NNUE_X86)
+    if (__builtin_cpu_supports("avx2"))
+        return SIMD_AVX2;
+    return __builtin_cpu_supports("sse4.1") ? SIMD_SSE41 : SIMD_SCALAR;
+#else
+    return SIMD_SCALAR;
+#endif
+}
+
+struct Kernels {
+    SimdLevel level;
+    UpdateKernel update;
+    OutputKernel output;
+
+    Kernels() : level(DetectSimd()), update(UpdateScalar), output(OutputScalar)
+    {
+#if defined(NNUE_X86)
+        if (level == SIMD_AVX2)
+        {
+            update = UpdateAvx2;
+            output = OutputAvx2;
+        }
+        else if (level == SIMD_SSE41)
+        {
+            update = UpdateSse41;
+            output = OutputSse41;
+        }
+#endif
+    }
+} kernels;
+
+}
+
+// Reads into a scratch network and only replaces this one once the header,
+// every block and the end of the file check out, so a bad file leaves the
+// current weights in place.
+bool Network::Load(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+
+    std::unique_ptr<Network> loaded(new Network());
+    uint32_t header[3];
+    bool ok = fread(header, sizeof(header), 1, file) == 1
+        && header[0] == NNUE_MAGIC && header[1] == NNUE_VERSION && header[2] == (uint32_t)NNUE_HIDDEN
+        && fread(loaded->featureWeights, sizeof(loaded->featureWeights), 1, file) == 1
+        && fread(loaded->featureBiases, sizeof(loaded->featureBiases), 1, file) == 1
+        && fread(loaded->outputWeights, sizeof(loaded->outputWeights), 1, file) == 1
+        && fread(&loaded->outputBias, sizeof(loaded->outputBias), 1, file) == 1
+        && fgetc(file) == EOF;
+    fclose(file);
+    if (ok)
+        *this = *loaded;
+    return ok;
+}
+
+bool Network::Save(const std::string& path) const
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+
+    uint32_t header[3] = {NNUE_MAGIC, NNUE_VERSION, (uint32_t)NNUE_HIDDEN};
+    bool ok = fwrite(header, sizeof(header), 1, file) == 1
+        && fwrite(featureWeights, sizeof(featureWeights), 1, file) == 1
+        && fwrite(featureBiases, sizeof(featureBiases), 1, file) == 1
+        && fwrite(outputWeights, sizeof(outputWeights), 1, file) == 1
+        && fwrite(&outputBias, sizeof(outputBias), 1, file) == 1;
+    return fclose(file) == 0 && ok;
+}
+
+// Small random weights, for timing the kernels and as a starting point for
+// training. A fixed seed gives the same network every time.
+void Network::Randomize(uint64_t seed)
+{
+    auto next = [&seed]() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    };
+    for (auto& column : featureWeights)
+    {
+        for (int16_t& weight : column)
+            weight = (int16_t)((int)(next() % 33) - 16);
+    }
+    for (int16_t& bias : featureBiases)
+        bias = (int16_t)(next() % 64);
+    for (int16_t& weight : outputWeights)
+        weight = (int16_t)((int)(next() % 65) - 32);
+    outputBias = 0;
+}
+
+void Network::Refresh(const Board& board, Accumulator& accumulator) const
+{
+    for (int perspective = 0; perspective < 2; perspective++)
+    {
+        const int16_t* columns[NUM_SQUARES];
+        int count = 0;
+        Bitboard occupied = board.GetOccupied();
+        while (occupied)
+        {
+            int square = PopLsb(occupied);
+            columns[count++] = featureWeights[FeatureIndex(perspective, board.IsWhiteAt(square), board.GetTypeAt(square), square)];
+        }
+
+        int16_t* out = accumulator.values[perspective];
+        kernels.update(out, featureBiases, nullptr, 0, nullptr, 0);
+        for (int i = 0; i < count; i += 2)
+            kernels.update(out, out, columns + i, count - i >= 2 ? 2 : 1, nullptr, 0);
+    }
+}
+
+// Mirrors Board::MakeMove: before is the position the move is played from.
+void Network::Update(const Board& before, const BoardMove& move, const Accumulator& parent, Accumulator& child) const
+{
+    bool us = before.IsWhiteToMove();
+    int from = move.GetFrom();
+    int to = move.GetTo();
+    PieceType mover = before.GetTypeAt(from);
+
+    struct Change {
+        bool white;
+        PieceType type;
+        int square;
+    };
+    Change added[2];
+    Change removed[2];
+    int addCount = 0;
+    int removeCount = 0;
+
+    removed[removeCount++] = {us, mover, from};
+    added[addCount++] = {us, move.IsPromotion() ? move.GetPromotion() : mover, to};
+    if (move.IsEnPassant())
+        removed[removeCount++] = {!us, PieceType::PAWN, to + (us ? 8 : -8)};
+    else if (!before.IsEmpty(to))
+        removed[removeCount++] = {!us, before.GetTypeAt(to), to};
+    if (move.IsCastle())
+    {
+        bool kingside = move.GetFlags() == MOVE_KING_CASTLE;
+        removed[removeCount++] = {us, PieceType::ROOK, kingside ? from + 3 : from - 4};
+        added[addCount++] = {us, PieceType::ROOK, kingside ? from + 1 : from - 1};
+    }
+
+    for (int perspective = 0; perspective < 2; perspective++)
+    {
+        const int16_t* addColumns[2];
+        const int16_t* removeColumns[2];
+        for (int i = 0; i < addCount; i++)
+            addColumns[i] = featureWeights[FeatureIndex(perspective, added[i].white, added[i].type, added[i].square)];
+        for (int i = 0; i < removeCount; i++)
+            removeColumns[i] = featureWeights[FeatureIndex(perspective, removed[i].white, removed[i].type, removed[i].square)];
+        kernels.update(child.values[perspective], parent.values[perspective], addColumns, addCount, removeColumns, removeCount);
+    }
+}
+
+int Network::Evaluate(const Accumulator& accumulator, bool whiteToMove) const
+{
+    const int16_t* us = accumulator.values[whiteToMove ? 0 : 1];
+    const int16_t* them = accumulator.values[whiteToMove ? 1 : 0];
+    int64_t sum = (int64_t)kernels.output(us, them, outputWeights) + outputBias;
+    // Any weights file can push the output this far, so keep it out of the
+    // mate band the search reserves.
+    int64_t score = sum * NNUE_SCALE / (NNUE_QA * NNUE_QB);
+    const int64_t limit = MATE_SCORE - MAX_PLY - 1;
+    return (int)std::max(-limit, std::min(score, limit));
+}
+
+int Network::Evaluate(const Board& board) const
+{
+    Accumulator accumulator;
+    Refresh(board, accumulator);
+    return Evaluate(accumulator, board.IsWhiteToMove());
+}
+
+// A failed load keeps whatever evaluator was in use before.
+bool LoadNetwork(const std::string& path)
+{
+    if (!network.Load(path))
+        return false;
+    networkLoaded = true;
+    return true;
+}
+
+bool IsNetworkLoaded()
+{
+    return networkLoaded;
+}
+
+const Network& GetNetwork()
+{
+    return network;
+}
+
+SimdLevel GetSimdLevel()
+{
+    return kernels.level;
+}
+
+const char* GetSimdName()
+{
+    switch (kernels.level)
+    {
+    case SIMD_AVX2: return "avx2";
+    case SIMD_SSE41: return "sse4.1";
+    default: return "scalar";
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef NNUE_H
+#define NNUE_H
+
+#include "Board.h"
+#include <string>
+
+// A small efficiently updatable network: 768 inputs (side-relative piece
+// type, colour and square) feed a 256-wide hidden layer once from each
+// side's point of view, and the two halves, clipped to [0, QA], feed one
+// output. The hidden layer before clipping is the accumulator; a move only
+// adds and removes the columns of the few pieces it touches.
+const int NNUE_INPUTS = 2 * NUM_PIECE_TYPES * NUM_SQUARES;
+const int NNUE_HIDDEN = 256;
+const int NNUE_QA = 255;
+const int NNUE_QB = 64;
+const int NNUE_SCALE = 400;
+
+struct alignas(64) Accumulator {
+    int16_t values[2][NNUE_HIDDEN];
+};
+
+enum SimdLevel {
+    SIMD_SCALAR,
+    SIMD_SSE41,
+    SIMD_AVX2
+};
+
+// Weights file, little-endian: the magic "NNUE", a version and the hidden
+// size as uint32, then the int16 feature weights (input-major), feature
+// biases and output weights (side to move's half first), and an int32
+// output bias.
+class Network {
+private:
+    alignas(64) int16_t featureWeights[NNUE_INPUTS][NNUE_HIDDEN];
+    alignas(64) int16_t featureBiases[NNUE_HIDDEN];
+    alignas(64) int16_t outputWeights[2 * NNUE_HIDDEN];
+    int32_t outputBias;
+
+public:
+    bool Load(const std::string& path);
+    bool Save(const std::string& path) const;
+    void Randomize(uint64_t seed);
+
+    void Refresh(const Board& board, Accumulator& accumulator) const;
+    void Update(const Board& before, const BoardMove& move, const Accumulator& parent, Accumulator& child) const;
+    int Evaluate(const Accumulator& accumulator, bool whiteToMove) const;
+    int Evaluate(const Board& board) const;
+};
+
+// The process-wide network. Load it before any search starts; until then
+// the evaluator stays classical, and a failed load changes nothing.
+bool LoadNetwork(const std::string& path);
+bool IsNetworkLoaded();
+const Network& GetNetwork();
+
+// Instruction set the kernels were picked for on this CPU.
+SimdLevel GetSimdLevel();
+const char* GetSimdName();
+
+#endif
@@ -0,0 +1,31 @@
+#include "PawnTable.h"
+
+PawnTableStats& PawnTableStats::operator+=(const PawnTableStats& other)
+{
+    probes += other.probes;
+    hits += other.hits;
+    return *this;
+}
+
+PawnTable::PawnTable() : entries(SIZE)
+{
+}
+
+void PawnTable::Clear()
+{
+    entries.assign(SIZE, PawnEntry());
+    ResetStats();
+}
+
+// An empty slot has key 0, which is also the key of a board without pawns;
+// that board's pawn score is 0 as well, so the match is still right.
+bool PawnTable::Probe(uint64_t key, PawnEntry& entry)
+{
+    stats.probes++;
+    const PawnEntry& slot = entries[key & (SIZE - 1)];
+    if (slot.key != key)
+        return false;
+    stats.hits++;
+    entry = slot;
+    return true;
+}
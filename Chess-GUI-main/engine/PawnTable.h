@@ -0,0 +1,43 @@
+#ifndef PAWN_TABLE_H
+#define PAWN_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct PawnEntry {
+    uint64_t key = 0;
+    int16_t midgame = 0;
+    int16_t endgame = 0;
+};
+
+struct PawnTableStats {
+    uint64_t probes = 0;
+    uint64_t hits = 0;
+
+    PawnTableStats& operator+=(const PawnTableStats& other);
+    double GetHitRate() const { return probes ? (double)hits / probes : 0.0; }
+};
+
+// Pawn-structure scores keyed by the board's pawn key. Pawns move far less
+// often than pieces, so sibling nodes nearly always find their entry here.
+// Each search thread owns one, so neither entries nor counters are shared.
+class PawnTable {
+private:
+    static const size_t SIZE = 1 << 14;
+
+    std::vector<PawnEntry> entries;
+    PawnTableStats stats;
+
+public:
+    PawnTable();
+
+    void Clear();
+    bool Probe(uint64_t key, PawnEntry& entry);
+    void Store(const PawnEntry& entry) { entries[entry.key & (SIZE - 1)] = entry; }
+
+    const PawnTableStats& GetStats() const { return stats; }
+    void ResetStats() { stats = PawnTableStats(); }
+};
+
+#endif
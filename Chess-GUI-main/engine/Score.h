@@ -0,0 +1,10 @@
+#ifndef SCORE_H
+#define SCORE_H
+
+const int MAX_PLY = 64;
+const int MATE_SCORE = 32000;
+const int INFINITE_SCORE = 32001;
+
+inline bool IsMateScore(int score) { return score > MATE_SCORE - MAX_PLY || score < -MATE_SCORE + MAX_PLY; }
+
+#endif
@@ -0,0 +1,428 @@
+#include "Search.h"
+#include "Evaluate.h"
+#include "Rules.h"
+#include <algorithm>
+
+namespace {
+
+const int FUTILITY_DEPTH = 3;
+const int FUTILITY_MARGIN = 150;
+const int RAZOR_DEPTH = 2;
+const int RAZOR_MARGIN = 300;
+const int NULL_MOVE_DEPTH = 3;
+const int LMR_DEPTH = 3;
+const int LMR_MOVES = 3;
+const uint64_t YIELD_INTERVAL = 128;
+
+// Mate scores are stored relative to the node rather than the root, so that
+// they stay correct when the position is reached at another ply.
+int ScoreToTable(int score, int ply)
+{
+    if (score > MATE_SCORE - MAX_PLY)
+        return score + ply;
+    if (score < -MATE_SCORE + MAX_PLY)
+        return score - ply;
+    return score;
+}
+
+int ScoreFromTable(int score, int ply)
+{
+    if (score > MATE_SCORE - MAX_PLY)
+        return score - ply;
+    if (score < -MATE_SCORE + MAX_PLY)
+        return score + ply;
+    return score;
+}
+
+// Null-move pruning is unsound in pawn endings, where zugzwang is common.
+bool HasNonPawnMaterial(const Board& board)
+{
+    bool white = board.IsWhiteToMove();
+    return (board.GetSide(white) & ~board.GetPieces(PieceType::PAWN, white) & ~board.GetPieces(PieceType::KING, white)) != 0;
+}
+
+void MoveToFront(MoveList& moves, BoardMove move)
+{
+    BoardMove* found = std::find(moves.begin(), moves.end(), move);
+    if (found != moves.end())
+        std::rotate(moves.begin(), found, found + 1);
+}
+
+}
+
+Search::Search() : stopFlag(false), table(nullptr), threadIndex(0), useNetwork(false), accumulators(MAX_PLY + 1),
+    nodes(0), aborted(false)
+{
+}
+
+// Plays a move from the node at ply, bringing the child's accumulator up to
+// date from this node's when the network is in use.
+Board Search::ApplyMove(const Board& board, const BoardMove& move, int ply)
+{
+    if (useNetwork)
+        GetNetwork().Update(board, move, accumulators[ply], accumulators[ply + 1]);
+    return board.Apply(move);
+}
+
+int Search::EvaluateNode(const Board& board, int ply)
+{
+    if (useNetwork)
+        return GetNetwork().Evaluate(accumulators[ply], board.IsWhiteToMove());
+    return EvaluateClassical(board, &pawnTable);
+}
+
+// Follows the table's best moves from the root. Entries can be overwritten
+// or come from another line, so every move is checked before it is played.
+std::vector<BoardMove> Search::GetPrincipalVariation(const Board& board, BoardMove best, int maxLength) const
+{
+    std::vector<BoardMove> line = {best};
+    Board current = board.Apply(best);
+    TTEntry entry;
+    while ((int)line.size() < maxLength && table && table->Probe(current.GetKey(), entry)
+        && !entry.move.IsNull() && IsLegalMove(current, entry.move))
+    {
+        line.push_back(entry.move);
+        current = current.Apply(entry.move);
+    }
+    return line;
+}
+
+int64_t Search::GetElapsedMs() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+// The clock is only read every 1024 nodes; the stop flag and node budget
+// are cheap enough to test every time. A sliced search may be paused in the
+// yield callback, so the stop flag is read after it returns.
+bool Search::ShouldAbort()
+{
+    if (aborted)
+        return true;
+    if (yieldCallback && (nodes & (YIELD_INTERVAL - 1)) == 0)
+        yieldCallback();
+    if (stopFlag.load(std::memory_order_relaxed)
+        || (limits.nodes && nodes >= limits.nodes)
+        || (limits.moveTimeMs && (nodes & 1023) == 0 && GetElapsedMs() >= limits.moveTimeMs))
+        aborted = true;
+    return aborted;
+}
+
+// Searches captures until the position is quiet, so the static score is
+// never taken in the middle of an exchange. The side to move may stand pat
+// on the static score unless it is in check, when every evasion is tried.
+int Search::Quiescence(const Board& board, int ply, int alpha, int beta)
+{
+    nodes++;
+    if (ShouldAbort())
+        return 0;
+    if (ply >= MAX_PLY)
+        return EvaluateNode(board, ply);
+
+    bool inCheck = IsInCheck(board);
+    int bestScore = -INFINITE_SCORE;
+    if (!inCheck)
+    {
+        bestScore = EvaluateNode(board, ply);
+        if (bestScore >= beta)
+            return bestScore;
+        if (bestScore > alpha)
+            alpha = bestScore;
+    }
+
+    MovePicker picker = inCheck ? MovePicker(board, orderTables, BoardMove(), ply, BoardMove()) : MovePicker(board, orderTables);
+    int moveCount = 0;
+    while (true)
+    {
+        BoardMove move = picker.Next();
+        if (move.IsNull())
+            break;
+
+        moveCount++;
+        int score = -Quiescence(ApplyMove(board, move, ply), ply + 1, -beta, -alpha);
+        if (aborted)
+            return 0;
+        if (score > bestScore)
+        {
+            bestScore = score;
+            if (score > alpha)
+            {
+                alpha = score;
+                if (alpha >= beta)
+                    break;
+            }
+        }
+    }
+
+    if (inCheck && moveCount == 0)
+        return -MATE_SCORE + ply;
+    return bestScore;
+}
+
+int Search::Negamax(const Board& board, int depth, int ply, int alpha, int beta)
+{
+    if (depth <= 0 && options.quiescence)
+        return Quiescence(board, ply, alpha, beta);
+
+    nodes++;
+    if (ShouldAbort())
+        return 0;
+
+    if (ply > 0 && (IsFiftyMoveDraw(board) || history.IsRepetition(board)))
+        return 0;
+
+    if (depth <= 0 || ply >= MAX_PLY)
+        return EvaluateNode(board, ply);
+
+    TTEntry entry;
+    BoardMove hashMove;
+    if (table)
+        tableStats.probes++;
+    if (table && table->Probe(board.GetKey(), entry))
+    {
+        tableStats.hits++;
+        hashMove = entry.move;
+        int score = ScoreFromTable(entry.score, ply);
+        if (entry.depth >= depth
+            && (entry.bound == BOUND_EXACT
+                || (entry.bound == BOUND_LOWER && score >= beta)
+                || (entry.bound == BOUND_UPPER && score <= alpha)))
+            return score;
+    }
+
+    bool inCheck = IsInCheck(board);
+    bool pvNode = beta - alpha > 1;
+    int staticEval = inCheck ? -INFINITE_SCORE : EvaluateNode(board, ply);
+    BoardMove previous = moveStack[ply - 1];
+
+    // Prune whole nodes whose static score is far outside the window. None
+    // of this applies in check or on the principal variation.
+    if (!pvNode && !inCheck)
+    {
+        if (options.futility && depth <= FUTILITY_DEPTH && !IsMateScore(beta)
+            && staticEval - FUTILITY_MARGIN * depth >= beta)
+            return staticEval;
+
+        if (options.razoring && depth <= RAZOR_DEPTH && staticEval + RAZOR_MARGIN * depth <= alpha)
+        {
+            int score = options.quiescence ? Quiescence(board, ply, alpha, alpha + 1) : staticEval;
+            if (aborted)
+                return 0;
+            if (score <= alpha)
+                return score;
+        }
+
+        // Give the opponent a free move; if a reduced search still fails
+        // high, a real move would too. Two null moves in a row are not allowed.
+        if (options.nullMove && depth >= NULL_MOVE_DEPTH && !previous.IsNull() && staticEval >= beta
+            && HasNonPawnMaterial(board))
+        {
+            int reduction = depth >= 6 ? 3 : 2;
+            moveStack[ply] = BoardMove();
+            history.Push(board.GetKey());
+            if (useNetwork)
+                accumulators[ply + 1] = accumulators[ply];
+            int score = -Negamax(board.ApplyNullMove(), depth - 1 - reduction, ply + 1, -beta, -beta + 1);
+            history.Pop();
+            if (aborted)
+                return 0;
+            if (score >= beta)
+                return IsMateScore(score) ? beta : score;
+        }
+    }
+
+    // Quiet moves near the leaves that cannot bring the score up to alpha
+    // are skipped, unless they give check.
+    bool futile = options.futility && !pvNode && !inCheck && depth <= FUTILITY_DEPTH
+        && staticEval + FUTILITY_MARGIN * depth <= alpha;
+
+    // With ordering off the moves are searched in generator order, which
+    // is the baseline the move picker is measured against.
+    MovePicker picker(board, orderTables, hashMove, ply, previous);
+    MoveList unordered;
+    int unorderedIndex = 0;
+    if (!options.moveOrdering)
+        GenerateLegalMoves(board, unordered);
+
+    int originalAlpha = alpha;
+    int bestScore = -INFINITE_SCORE;
+    BoardMove bestMove;
+    BoardMove quietsTried[MAX_MOVES];
+    int quietCount = 0;
+    int moveCount = 0;
+
+    history.Push(board.GetKey());
+    while (true)
+    {
+        BoardMove move;
+        if (options.moveOrdering)
+            move = picker.Next();
+        else if (unorderedIndex < unordered.Size())
+            move = unordered[unorderedIndex++];
+        if (move.IsNull())
+            break;
+
+        moveCount++;
+        moveStack[ply] = move;
+        Board after = ApplyMove(board, move, ply);
+        bool quiet = !move.IsCapture() && !move.IsPromotion();
+        bool givesCheck = IsInCheck(after);
+        if (futile && quiet && !givesCheck && moveCount > 1)
+            continue;
+
+        // Late quiet moves are searched shallower with a null window first,
+        // and again at full depth only if they beat alpha.
+        int score;
+        if (options.lateMoveReductions && depth >= LMR_DEPTH && moveCount > LMR_MOVES && quiet && !inCheck && !givesCheck)
+        {
+            int reduction = moveCount > 2 * LMR_MOVES + 2 ? 2 : 1;
+            score = -Negamax(after, depth - 1 - reduction, ply + 1, -alpha - 1, -alpha);
+            if (score > alpha && !aborted)
+                score = -Negamax(after, depth - 1, ply + 1, -beta, -alpha);
+        }
+        else
+            score = -Negamax(after, depth - 1, ply + 1, -beta, -alpha);
+        if (aborted)
+            break;
+
+        if (quiet)
+            quietsTried[quietCount++] = move;
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestMove = move;
+            if (score > alpha)
+            {
+                alpha = score;
+                if (alpha >= beta)
+                {
+                    if (quiet && options.moveOrdering)
+                        orderTables.UpdateQuiet(board, ply, depth, move, previous, quietsTried, quietCount);
+                    break;
+                }
+            }
+        }
+    }
+    history.Pop();
+
+    if (aborted)
+        return 0;
+    if (moveCount == 0)
+        return IsInCheck(board) ? -MATE_SCORE + ply : 0;
+
+    if (table)
+    {
+        entry.move = bestMove;
+        entry.score = ScoreToTable(bestScore, ply);
+        entry.depth = depth;
+        entry.bound = bestScore >= beta ? BOUND_LOWER : (bestScore > originalAlpha ? BOUND_EXACT : BOUND_UPPER);
+        tableStats.stores++;
+        if (table->Store(board.GetKey(), entry))
+            tableStats.collisions++;
+    }
+    return bestScore;
+}
+
+SearchResult Search::Run(const Board& board, const PositionHistory& gameHistory, const SearchLimits& searchLimits)
+{
+    limits = searchLimits;
+    history = gameHistory;
+    startTime = std::chrono::steady_clock::now();
+    nodes = 0;
+    tableStats = TTStats();
+    pawnTable.ResetStats();
+    aborted = false;
+    orderTables.Clear();
+    useNetwork = IsNetworkLoaded();
+    if (useNetwork)
+        GetNetwork().Refresh(board, accumulators[0]);
+
+    SearchResult result;
+    MoveList rootMoves;
+    GenerateLegalMoves(board, rootMoves);
+    if (rootMoves.IsEmpty())
+        return result;
+
+    // Helpers start from a different root move, and every other helper
+    // searches one ply deeper than the main thread.
+    if (threadIndex > 0)
+        std::rotate(rootMoves.begin(), rootMoves.begin() + threadIndex % rootMoves.Size(), rootMoves.end());
+    int depthOffset = threadIndex % 2;
+    result.bestMove = rootMoves[0];
+
+    history.Push(board.GetKey());
+    for (int depth = 1; depth <= limits.depth && depth + depthOffset <= MAX_PLY; depth++)
+    {
+        int searchDepth = depth + depthOffset;
+        int alpha = -INFINITE_SCORE;
+        BoardMove best = rootMoves[0];
+        int searched = 0;
+
+        for (const BoardMove& move : rootMoves)
+        {
+            moveStack[0] = move;
+            Board after = ApplyMove(board, move, 0);
+            int score = -Negamax(after, searchDepth - 1, 1, -INFINITE_SCORE, -alpha);
+            if (aborted)
+                break;
+            searched++;
+            if (score > alpha)
+            {
+                alpha = score;
+                best = move;
+            }
+        }
+
+        // An interrupted iteration is discarded. At depth 1 it is all we
+        // have, so keep the best of the moves that finished, if any did.
+        if (aborted)
+        {
+            if (depth == 1 && searched > 0)
+            {
+                result.bestMove = best;
+                result.score = alpha;
+                result.depth = searchDepth;
+            }
+            break;
+        }
+
+        result.bestMove = best;
+        result.score = alpha;
+        result.depth = searchDepth;
+        if (table)
+        {
+            TTEntry entry;
+            entry.move = best;
+            entry.score = ScoreToTable(alpha, 0);
+            entry.depth = searchDepth;
+            entry.bound = BOUND_EXACT;
+            table->Store(board.GetKey(), entry);
+        }
+
+        if (infoCallback)
+        {
+            SearchInfo info;
+            info.depth = searchDepth;
+            info.score = alpha;
+            info.nodes = nodes;
+            info.timeMs = GetElapsedMs();
+            info.hashFullPermille = table ? table->GetFillPermille() : 0;
+            info.principalVariation = GetPrincipalVariation(board, best, searchDepth);
+            infoCallback(info);
+        }
+
+        // Search the best move first in the next iteration.
+        MoveToFront(rootMoves, best);
+
+        if (IsMateScore(alpha))
+            break;
+    }
+    history.Pop();
+
+    result.nodes = nodes;
+    result.tableStats = tableStats;
+    result.pawnStats = pawnTable.GetStats();
+    result.timeMs = GetElapsedMs();
+    return result;
+}
@@ -0,0 +1,108 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "Board.h"
+#include "History.h"
+#include "MovePicker.h"
+#include "Nnue.h"
+#include "PawnTable.h"
+#include "Score.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+// A zero field means no limit of that kind; the search always finishes
+// depth 1 so that there is a move to play.
+struct SearchLimits {
+    int depth = MAX_PLY;
+    int64_t moveTimeMs = 0;
+    uint64_t nodes = 0;
+};
+
+// Search features that can be switched off to measure what they are worth.
+struct SearchOptions {
+    bool moveOrdering = true;
+    bool quiescence = true;
+    bool nullMove = true;
+    bool lateMoveReductions = true;
+    bool futility = true;
+    bool razoring = true;
+};
+
+struct SearchResult {
+    BoardMove bestMove;
+    int score = 0;
+    int depth = 0;
+    uint64_t nodes = 0;
+    int64_t timeMs = 0;
+    TTStats tableStats;
+    PawnTableStats pawnStats;
+};
+
+// Progress of the main search thread, reported after every completed
+// iteration. Nodes are the main thread's own; helpers are only counted in
+// the final result.
+struct SearchInfo {
+    int depth = 0;
+    int score = 0;
+    uint64_t nodes = 0;
+    int64_t timeMs = 0;
+    int hashFullPermille = 0;
+    std::vector<BoardMove> principalVariation;
+};
+
+typedef std::function<void(const SearchInfo&)> InfoCallback;
+
+// Called every few hundred nodes, on the search's own thread, so that a
+// driver can pause the search in between.
+typedef std::function<void()> YieldCallback;
+
+// Iterative-deepening alpha-beta over copy-made boards. Run blocks until a
+// limit is hit or Stop is called from another thread. Several searches can
+// share one transposition table; helpers (thread index above 0) vary their
+// root order and depth so that they fill the table with different work.
+class Search {
+private:
+    std::atomic<bool> stopFlag;
+    TranspositionTable* table;
+    int threadIndex;
+    SearchLimits limits;
+    SearchOptions options;
+    MoveOrderTables orderTables;
+    BoardMove moveStack[MAX_PLY + 1];
+    bool useNetwork;
+    std::vector<Accumulator> accumulators;
+    PawnTable pawnTable;
+    PositionHistory history;
+    InfoCallback infoCallback;
+    YieldCallback yieldCallback;
+    std::chrono::steady_clock::time_point startTime;
+    uint64_t nodes;
+    TTStats tableStats;
+    bool aborted;
+
+    int Negamax(const Board& board, int depth, int ply, int alpha, int beta);
+    int Quiescence(const Board& board, int ply, int alpha, int beta);
+    bool ShouldAbort();
+    Board ApplyMove(const Board& board, const BoardMove& move, int ply);
+    int EvaluateNode(const Board& board, int ply);
+    std::vector<BoardMove> GetPrincipalVariation(const Board& board, BoardMove best, int maxLength) const;
+
+public:
+    Search();
+
+    void SetTable(TranspositionTable* sharedTable) { table = sharedTable; }
+    void SetThreadIndex(int index) { threadIndex = index; }
+    void SetOptions(const SearchOptions& searchOptions) { options = searchOptions; }
+    void SetInfoCallback(const InfoCallback& callback) { infoCallback = callback; }
+    void SetYieldCallback(const YieldCallback& callback) { yieldCallback = callback; }
+
+    SearchResult Run(const Board& board, const PositionHistory& gameHistory, const SearchLimits& searchLimits);
+    void Stop() { stopFlag = true; }
+    void ClearStop() { stopFlag = false; }
+    int64_t GetElapsedMs() const;
+};
+
+#endif
@@ -0,0 +1,122 @@
+#include "See.h"
+#include "Attacks.h"
+#include "Evaluate.h"
+#include <algorithm>
+
+// The king counts as priceless here so it is never traded into a defended square.
+static const int SEE_KING_VALUE = 20000;
+
+static const PieceType SEE_ORDER[NUM_PIECE_TYPES] = {
+    PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN, PieceType::KING};
+
+static int SeeValue(PieceType type)
+{
+    return type == PieceType::KING ? SEE_KING_VALUE : PIECE_VALUES[(int)type];
+}
+
+Bitboard GetAttackersTo(const Board& board, int square, Bitboard occupied)
+{
+    Bitboard diagonal = board.GetPieces(PieceType::BISHOP, true) | board.GetPieces(PieceType::BISHOP, false)
+        | board.GetPieces(PieceType::QUEEN, true) | board.GetPieces(PieceType::QUEEN, false);
+    Bitboard orthogonal = board.GetPieces(PieceType::ROOK, true) | board.GetPieces(PieceType::ROOK, false)
+        | board.GetPieces(PieceType::QUEEN, true) | board.GetPieces(PieceType::QUEEN, false);
+
+    return ((GetPawnAttacks(square, false) & board.GetPieces(PieceType::PAWN, true))
+        | (GetPawnAttacks(square, true) & board.GetPieces(PieceType::PAWN, false))
+        | (GetKnightAttacks(square) & (board.GetPieces(PieceType::KNIGHT, true) | board.GetPieces(PieceType::KNIGHT, false)))
+        | (GetKingAttacks(square) & (board.GetPieces(PieceType::KING, true) | board.GetPieces(PieceType::KING, false)))
+        | (GetBishopAttacks(square, occupied) & diagonal)
+        | (GetRookAttacks(square, occupied) & orthogonal)) & occupied;
+}
+
+// The swap loop: the piece on from takes whatever is worth captured on to,
+// then the sides alternate, each using its cheapest remaining attacker.
+// Removing a piece from the occupancy uncovers sliders behind it.
+static int Exchange(const Board& board, int from, int to, int captured)
+{
+    int gain[32];
+    int depth = 0;
+    bool side = board.IsWhiteAt(from);
+    Bitboard occupied = board.GetOccupied() & ~SquareBB(from);
+    int onSquare = SeeValue(board.GetTypeAt(from));
+    gain[0] = captured;
+
+    while (true)
+    {
+        side = !side;
+        Bitboard attackers = GetAttackersTo(board, to, occupied) & board.GetSide(side);
+        if (!attackers)
+            break;
+
+        PieceType type = PieceType::KING;
+        for (PieceType candidate : SEE_ORDER)
+        {
+            if (attackers & board.GetPieces(candidate, side))
+            {
+                type = candidate;
+                break;
+            }
+        }
+
+        depth++;
+        gain[depth] = onSquare - gain[depth - 1];
+        if (depth == 31)
+            break;
+
+        occupied &= ~SquareBB(Lsb(attackers & board.GetPieces(type, side)));
+        onSquare = SeeValue(type);
+    }
+
+    // Walk back up: each side either takes or stands pat, whichever is better.
+    for (; depth > 0; depth--)
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+    return gain[0];
+}
+
+int See(const Board& board, const BoardMove& move)
+{
+    int to = move.GetTo();
+    int captured = 0;
+    if (move.IsEnPassant())
+        captured = PIECE_VALUES[(int)PieceType::PAWN];
+    else if (!board.IsEmpty(to))
+        captured = SeeValue(board.GetTypeAt(to));
+
+    if (!move.IsEnPassant())
+        return Exchange(board, move.GetFrom(), to, captured);
+
+    Board after = board;
+    after.RemovePiece(to + (board.IsWhiteToMove() ? 8 : -8));
+    return Exchange(after, move.GetFrom(), to, captured);
+}
+
+bool SeeAtLeast(const Board& board, const BoardMove& move, int threshold)
+{
+    return See(board, move) >= threshold;
+}
+
+int SeeThreat(const Board& board, int square)
+{
+    if (board.IsEmpty(square))
+        return 0;
+
+    bool owner = board.IsWhiteAt(square);
+    Bitboard attackers = GetAttackersTo(board, square, board.GetOccupied()) & board.GetSide(!owner);
+    int best = 0;
+    while (attackers)
+        best = std::max(best, Exchange(board, PopLsb(attackers), square, SeeValue(board.GetTypeAt(square))));
+    return best;
+}
+
+Bitboard GetHangingPieces(const Board& board, bool isWhite)
+{
+    Bitboard hanging = 0;
+    Bitboard pieces = board.GetSide(isWhite) & ~board.GetPieces(PieceType::KING, isWhite);
+    while (pieces)
+    {
+        int square = PopLsb(pieces);
+        if (SeeThreat(board, square) > 0)
+            hanging |= SquareBB(square);
+    }
+    return hanging;
+}
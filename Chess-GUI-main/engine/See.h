@@ -0,0 +1,25 @@
+#ifndef SEE_H
+#define SEE_H
+
+#include "Board.h"
+
+// Static exchange evaluation: the material a side comes out with after both
+// sides keep recapturing on one square with their least valuable attacker,
+// each free to stop when carrying on would lose material. Pins are ignored.
+
+// Pieces of either side attacking square, given the occupancy.
+Bitboard GetAttackersTo(const Board& board, int square, Bitboard occupied);
+
+// Exchange value of move for the side playing it, in centipawns. Quiet
+// moves score the risk of the piece being taken on its destination.
+int See(const Board& board, const BoardMove& move);
+bool SeeAtLeast(const Board& board, const BoardMove& move, int threshold);
+
+// What the opponent wins by starting an exchange on the piece standing on
+// square; zero when the piece is safe or the square is empty.
+int SeeThreat(const Board& board, int square);
+
+// Every piece of the given side that its opponent can win material against.
+Bitboard GetHangingPieces(const Board& board, bool isWhite);
+
+#endif
@@ -0,0 +1,109 @@
+#include "SlicedSearch.h"
+
+// The table starts small; SetHashSize grows it once this driver is chosen.
+SlicedSearch::SlicedSearch() : table(1), searchTurn(false), thinking(false), finished(false)
+{
+    search.SetTable(&table);
+    search.SetYieldCallback([this]() { Yield(); });
+}
+
+SlicedSearch::~SlicedSearch()
+{
+    Stop();
+}
+
+bool SlicedSearch::SetHashSize(size_t megabytes)
+{
+    Stop();
+    return table.Resize(megabytes);
+}
+
+void SlicedSearch::SetOptions(const SearchOptions& options)
+{
+    Stop();
+    search.SetOptions(options);
+}
+
+void SlicedSearch::NewGame()
+{
+    Stop();
+    table.Clear();
+}
+
+// Runs on the worker. Hands control back once the slice is over and waits
+// for the next one.
+void SlicedSearch::Yield()
+{
+    if (std::chrono::steady_clock::now() < sliceEnd)
+        return;
+    std::unique_lock<std::mutex> lock(mutex);
+    searchTurn = false;
+    turnChanged.notify_all();
+    turnChanged.wait(lock, [this]() { return searchTurn; });
+}
+
+// Runs on the caller. Lets the worker run until it yields or finishes.
+void SlicedSearch::Resume(std::chrono::steady_clock::time_point until)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    sliceEnd = until;
+    searchTurn = true;
+    turnChanged.notify_all();
+    turnChanged.wait(lock, [this]() { return !searchTurn; });
+}
+
+void SlicedSearch::Start(const Board& board, const PositionHistory& history, const SearchLimits& limits)
+{
+    Stop();
+    search.ClearStop();
+    table.NewSearch();
+    finished = false;
+    thinking = true;
+    searchTurn = false;
+    worker = std::thread([this, board, history, limits]() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            turnChanged.wait(lock, [this]() { return searchTurn; });
+        }
+        SearchResult searchResult = search.Run(board, history, limits);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        result = searchResult;
+        thinking = false;
+        finished = true;
+        searchTurn = false;
+        turnChanged.notify_all();
+    });
+}
+
+// Gives the search up to the given time, then returns. Does nothing when no
+// search is running.
+void SlicedSearch::Step(int64_t microseconds)
+{
+    if (!thinking)
+        return;
+    Resume(std::chrono::steady_clock::now() + std::chrono::microseconds(microseconds));
+    if (finished && worker.joinable())
+        worker.join();
+}
+
+// Cancels a running search and discards whatever it found. The worker has
+// to run once more to see the stop flag, so it gets an unlimited slice.
+void SlicedSearch::Stop()
+{
+    if (worker.joinable())
+    {
+        search.Stop();
+        if (thinking)
+            Resume(std::chrono::steady_clock::time_point::max());
+        worker.join();
+    }
+    thinking = false;
+    finished = false;
+}
+
+SearchResult SlicedSearch::TakeResult()
+{
+    finished = false;
+    return result;
+}
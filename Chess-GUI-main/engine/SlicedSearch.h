@@ -0,0 +1,53 @@
+#ifndef SLICED_SEARCH_H
+#define SLICED_SEARCH_H
+
+#include "Search.h"
+#include "TranspositionTable.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Runs one search in slices on the caller's schedule, for single-core
+// machines where a free-running engine thread would steal time from
+// rendering. The search keeps its own stack on a worker thread, but control
+// is handed back and forth like a coroutine: the worker only runs while
+// Step waits for it, and yields once the slice is spent, so the two never
+// compete for the CPU. Time limits still count wall-clock time.
+class SlicedSearch {
+private:
+    TranspositionTable table;
+    Search search;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable turnChanged;
+    bool searchTurn;
+    bool thinking;
+    bool finished;
+    std::chrono::steady_clock::time_point sliceEnd;
+    SearchResult result;
+
+    void Yield();
+    void Resume(std::chrono::steady_clock::time_point until);
+
+public:
+    SlicedSearch();
+    ~SlicedSearch();
+
+    SlicedSearch(const SlicedSearch&) = delete;
+    SlicedSearch& operator=(const SlicedSearch&) = delete;
+
+    bool SetHashSize(size_t megabytes);
+    void SetOptions(const SearchOptions& options);
+    void NewGame();
+
+    void Start(const Board& board, const PositionHistory& history, const SearchLimits& limits);
+    void Step(int64_t microseconds);
+    void Stop();
+
+    bool IsThinking() const { return thinking; }
+    bool HasResult() const { return finished; }
+    SearchResult TakeResult();
+};
+
+#endif
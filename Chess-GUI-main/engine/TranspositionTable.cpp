@@ -0,0 +1,190 @@
+#include "TranspositionTable.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// Data word layout: move in bits 0-15, score 16-31, depth 32-39, bound
+// 40-41 and the search generation 42-49.
+uint64_t Pack(const TTEntry& entry, uint8_t generation)
+{
+    return (uint64_t)entry.move.GetData()
+        | ((uint64_t)(uint16_t)(int16_t)entry.score << 16)
+        | ((uint64_t)(uint8_t)entry.depth << 32)
+        | ((uint64_t)entry.bound << 40)
+        | ((uint64_t)generation << 42);
+}
+
+TTEntry Unpack(uint64_t data)
+{
+    TTEntry entry;
+    entry.move = BoardMove((int)(data & 63), (int)((data >> 6) & 63), (int)((data >> 12) & 15));
+    entry.score = (int16_t)(uint16_t)(data >> 16);
+    entry.depth = (uint8_t)(data >> 32);
+    entry.bound = (TTBound)((data >> 40) & 3);
+    return entry;
+}
+
+int DepthOf(uint64_t data) { return (uint8_t)(data >> 32); }
+uint8_t GenerationOf(uint64_t data) { return (uint8_t)(data >> 42); }
+
+// Large tables are aligned to 2 MB and, on Linux, marked for transparent
+// huge pages so that random probes do not thrash the TLB.
+void* AllocateTable(size_t bytes)
+{
+#if defined(_WIN32)
+    return _aligned_malloc(bytes, 64);
+#else
+    void* memory = nullptr;
+    size_t alignment = bytes >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : 64;
+    if (posix_memalign(&memory, alignment, bytes) != 0)
+        return nullptr;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (bytes >= HUGE_PAGE_SIZE)
+        madvise(memory, bytes, MADV_HUGEPAGE);
+#endif
+    return memory;
+#endif
+}
+
+void FreeTable(void* memory)
+{
+#if defined(_WIN32)
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
+
+}
+
+TTStats& TTStats::operator+=(const TTStats& other)
+{
+    probes += other.probes;
+    hits += other.hits;
+    stores += other.stores;
+    collisions += other.collisions;
+    return *this;
+}
+
+TranspositionTable::TranspositionTable(size_t megabytes)
+    : buckets(nullptr), bucketCount(0), generation(0)
+{
+    if (!Resize(megabytes))
+        throw std::bad_alloc();
+}
+
+TranspositionTable::~TranspositionTable()
+{
+    Free();
+}
+
+void TranspositionTable::Free()
+{
+    if (buckets)
+        FreeTable(buckets);
+    buckets = nullptr;
+    bucketCount = 0;
+}
+
+// The bucket count is rounded down to a power of two so a key maps to a
+// bucket with a mask. The old table is only freed once the new one is
+// allocated; if that fails, the old table stays as it was.
+bool TranspositionTable::Resize(size_t megabytes)
+{
+    size_t wanted = (megabytes ? megabytes : 1) * 1024 * 1024 / sizeof(Bucket);
+    size_t count = 1;
+    while (count * 2 <= wanted)
+        count *= 2;
+
+    Bucket* resized = static_cast<Bucket*>(AllocateTable(count * sizeof(Bucket)));
+    if (!resized)
+        return false;
+    Free();
+    buckets = resized;
+    bucketCount = count;
+    Clear();
+    return true;
+}
+
+void TranspositionTable::Clear()
+{
+    memset(static_cast<void*>(buckets), 0, bucketCount * sizeof(Bucket));
+    generation = 0;
+}
+
+bool TranspositionTable::Probe(uint64_t key, TTEntry& entry) const
+{
+    const Bucket& bucket = buckets[key & (bucketCount - 1)];
+    for (const Slot& slot : bucket.slots)
+    {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if (data != 0 && (check ^ data) == key)
+        {
+            entry = Unpack(data);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns true when the store evicted a live entry for another position.
+bool TranspositionTable::Store(uint64_t key, const TTEntry& entry)
+{
+    Bucket& bucket = buckets[key & (bucketCount - 1)];
+    Slot* target = nullptr;
+    int worst = 0x7FFFFFFF;
+    uint64_t replaced = 0;
+
+    for (Slot& slot : bucket.slots)
+    {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if (data == 0 || (check ^ data) == key)
+        {
+            target = &slot;
+            replaced = 0;
+            break;
+        }
+
+        int age = (uint8_t)(generation - GenerationOf(data));
+        int value = DepthOf(data) - 8 * age;
+        if (value < worst)
+        {
+            worst = value;
+            target = &slot;
+            replaced = data;
+        }
+    }
+
+    uint64_t data = Pack(entry, generation);
+    target->check.store(key ^ data, std::memory_order_relaxed);
+    target->data.store(data, std::memory_order_relaxed);
+    return replaced != 0;
+}
+
+// Share of the first thousand buckets' slots written during this search.
+int TranspositionTable::GetFillPermille() const
+{
+    size_t sample = bucketCount < 1000 ? bucketCount : 1000;
+    size_t used = 0;
+    for (size_t i = 0; i < sample; i++)
+    {
+        for (const Slot& slot : buckets[i].slots)
+        {
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            if (data != 0 && GenerationOf(data) == generation)
+                used++;
+        }
+    }
+    return (int)(used * 1000 / (sample * BUCKET_SIZE));
+}
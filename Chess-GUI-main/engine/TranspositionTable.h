@@ -0,0 +1,76 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include "BoardMove.h"
+#include <atomic>
+#include <cstddef>
+
+enum TTBound : uint8_t {
+    BOUND_NONE,
+    BOUND_UPPER,
+    BOUND_LOWER,
+    BOUND_EXACT
+};
+
+struct TTEntry {
+    BoardMove move;
+    int score = 0;
+    int depth = 0;
+    TTBound bound = BOUND_NONE;
+};
+
+// Counted by each search thread and summed by the engine, so that the
+// shared table itself carries no contended counters.
+struct TTStats {
+    uint64_t probes = 0;
+    uint64_t hits = 0;
+    uint64_t stores = 0;
+    uint64_t collisions = 0;
+
+    TTStats& operator+=(const TTStats& other);
+    double GetHitRate() const { return probes ? (double)hits / probes : 0.0; }
+};
+
+// Shared by every search thread without locks. Each slot stores the data
+// word and the key XOR the data, so a slot torn by two concurrent writers
+// fails verification and reads as a miss. Slots come in cache-line sized
+// buckets of four; a store replaces the shallowest entry, counting entries
+// from earlier searches as shallower the older they are.
+class TranspositionTable {
+private:
+    static const int BUCKET_SIZE = 4;
+
+    struct Slot {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[BUCKET_SIZE];
+    };
+
+    Bucket* buckets;
+    size_t bucketCount;
+    uint8_t generation;
+
+    void Free();
+
+public:
+    explicit TranspositionTable(size_t megabytes = 16);
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    bool Resize(size_t megabytes);
+    void Clear();
+    void NewSearch() { generation++; }
+
+    bool Probe(uint64_t key, TTEntry& entry) const;
+    bool Store(uint64_t key, const TTEntry& entry);
+
+    size_t GetSizeBytes() const { return bucketCount * sizeof(Bucket); }
+    int GetFillPermille() const;
+};
+
+#endif
@@ -0,0 +1,336 @@
+#include "Uci.h"
+#include "Engine.h"
+#include "Nnue.h"
+#include "Rules.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+const char* START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+const int MAX_HASH_MB = 65536;
+const int MAX_THREADS = 256;
+const int64_t MOVE_OVERHEAD_MS = 30;
+
+// Commands flow from the input thread to the protocol thread through a
+// queue. "stop" and "quit" also stop a running search directly, so they
+// take effect at the search's next node rather than after the queue.
+class UciSession {
+private:
+    std::istream& input;
+    std::ostream& output;
+    Engine engine;
+    Board board;
+    PositionHistory history;
+
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<std::string> commands;
+
+    std::mutex outputMutex;
+    std::mutex searchMutex;
+    std::condition_variable stopReady;
+    bool searching;
+    bool stopRequested;
+    bool waitForStop;
+    std::thread waiter;
+
+    void Send(const std::string& line);
+    void ReadInput();
+    void HandlePosition(std::istringstream& stream);
+    void HandleGo(std::istringstream& stream);
+    void HandleSetOption(std::istringstream& stream);
+    void RequestStop();
+    void WaitForSearch();
+    void SendInfo(const SearchInfo& info);
+
+public:
+    UciSession(std::istream& in, std::ostream& out);
+    int Run();
+};
+
+std::string ScoreToString(int score)
+{
+    if (!IsMateScore(score))
+        return "cp " + std::to_string(score);
+    int plies = MATE_SCORE - std::abs(score);
+    int moves = (plies + 1) / 2;
+    return "mate " + std::to_string(score > 0 ? moves : -moves);
+}
+
+bool ParseMove(const Board& board, const std::string& text, BoardMove& move)
+{
+    MoveList moves;
+    GenerateLegalMoves(board, moves);
+    for (const BoardMove& candidate : moves)
+    {
+        if (MoveToString(candidate) == text)
+        {
+            move = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+UciSession::UciSession(std::istream& in, std::ostream& out) : input(in), output(out), searching(false),
+    stopRequested(false), waitForStop(false)
+{
+    board.SetFen(START_FEN);
+    engine.SetInfoCallback([this](const SearchInfo& info) { SendInfo(info); });
+}
+
+void UciSession::Send(const std::string& line)
+{
+    std::lock_guard<std::mutex> lock(outputMutex);
+    output << line << std::endl;
+}
+
+void UciSession::ReadInput()
+{
+    std::string line;
+    while (std::getline(input, line))
+    {
+        std::istringstream stream(line);
+        std::string command;
+        stream >> command;
+        if (command == "stop" || command == "quit")
+            RequestStop();
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        commands.push_back(line);
+        queueReady.notify_one();
+        if (command == "quit")
+            return;
+    }
+
+    RequestStop();
+    std::lock_guard<std::mutex> lock(queueMutex);
+    commands.push_back("quit");
+    queueReady.notify_one();
+}
+
+void UciSession::RequestStop()
+{
+    std::lock_guard<std::mutex> lock(searchMutex);
+    stopRequested = true;
+    if (searching)
+        engine.RequestStop();
+    stopReady.notify_all();
+}
+
+void UciSession::WaitForSearch()
+{
+    if (waiter.joinable())
+        waiter.join();
+}
+
+void UciSession::SendInfo(const SearchInfo& info)
+{
+    std::ostringstream line;
+    line << "info depth " << info.depth << " score " << ScoreToString(info.score) << " nodes " << info.nodes
+        << " nps " << (info.timeMs > 0 ? info.nodes * 1000 / info.timeMs : info.nodes) << " time " << info.timeMs
+        << " hashfull " << info.hashFullPermille << " pv";
+    for (const BoardMove& move : info.principalVariation)
+        line << " " << MoveToString(move);
+    Send(line.str());
+}
+
+void UciSession::HandlePosition(std::istringstream& stream)
+{
+    std::string token;
+    stream >> token;
+    std::string fen;
+    if (token == "startpos")
+    {
+        fen = START_FEN;
+        stream >> token;
+    }
+    else if (token == "fen")
+    {
+        while (stream >> token && token != "moves")
+            fen += (fen.empty() ? "" : " ") + token;
+    }
+    else
+        return;
+
+    Board position;
+    if (!position.SetFen(fen))
+    {
+        Send("info string invalid fen " + fen);
+        return;
+    }
+
+    PositionHistory positionHistory;
+    while (stream >> token)
+    {
+        BoardMove move;
+        if (!ParseMove(position, token, move))
+        {
+            Send("info string illegal move " + token);
+            break;
+        }
+        positionHistory.Push(position.GetKey());
+        position = position.Apply(move);
+    }
+    board = position;
+    history = positionHistory;
+}
+
+// With a clock, spends about a thirtieth of the remaining time (or an even
+// share until the next time control) plus most of the increment.
+void UciSession::HandleGo(std::istringstream& stream)
+{
+    SearchLimits limits;
+    int64_t times[2] = {0, 0};
+    int64_t increments[2] = {0, 0};
+    int movesToGo = 0;
+    bool infinite = false;
+
+    std::string token;
+    while (stream >> token)
+    {
+        if (token == "wtime") stream >> times[SIDE_WHITE];
+        else if (token == "btime") stream >> times[SIDE_BLACK];
+        else if (token == "winc") stream >> increments[SIDE_WHITE];
+        else if (token == "binc") stream >> increments[SIDE_BLACK];
+        else if (token == "movestogo") stream >> movesToGo;
+        else if (token == "depth") stream >> limits.depth;
+        else if (token == "nodes") stream >> limits.nodes;
+        else if (token == "movetime") stream >> limits.moveTimeMs;
+        else if (token == "infinite" || token == "ponder") infinite = true;
+    }
+
+    int side = board.IsWhiteToMove() ? SIDE_WHITE : SIDE_BLACK;
+    if (!infinite && !limits.moveTimeMs && times[side] > 0)
+    {
+        int64_t share = times[side] / (movesToGo > 0 ? movesToGo + 1 : 30) + increments[side] * 3 / 4;
+        int64_t available = std::max<int64_t>(times[side] - MOVE_OVERHEAD_MS, 1);
+        limits.moveTimeMs = std::max<int64_t>(std::min(share, available), 1);
+    }
+    if (limits.moveTimeMs)
+        limits.moveTimeMs = std::max<int64_t>(limits.moveTimeMs - (limits.moveTimeMs > 2 * MOVE_OVERHEAD_MS ? MOVE_OVERHEAD_MS : 0), 1);
+
+    WaitForSearch();
+    {
+        std::lock_guard<std::mutex> lock(searchMutex);
+        stopRequested = false;
+        waitForStop = infinite;
+        searching = true;
+        engine.Start(board, history, limits);
+    }
+
+    // An infinite search holds its best move back until "stop", as UCI
+    // requires, even if it finishes early.
+    waiter = std::thread([this]() {
+        SearchResult result = engine.TakeResult();
+        std::unique_lock<std::mutex> lock(searchMutex);
+        searching = false;
+        stopReady.wait(lock, [this]() { return !waitForStop || stopRequested; });
+        lock.unlock();
+        Send("bestmove " + (result.bestMove.IsNull() ? std::string("0000") : MoveToString(result.bestMove)));
+    });
+}
+
+void UciSession::HandleSetOption(std::istringstream& stream)
+{
+    std::string token;
+    std::string name;
+    std::string value;
+    stream >> token;
+    while (stream >> token && token != "value")
+        name += (name.empty() ? "" : " ") + token;
+    while (stream >> token)
+        value += (value.empty() ? "" : " ") + token;
+
+    WaitForSearch();
+    if (name == "Hash")
+    {
+        int megabytes = std::max(1, std::min(atoi(value.c_str()), MAX_HASH_MB));
+        if (!engine.SetHashSize((size_t)megabytes))
+            Send("info string could not allocate " + std::to_string(megabytes) + " MB of hash, keeping "
+                + std::to_string(engine.GetHashSizeBytes() >> 20) + " MB");
+    }
+    else if (name == "Threads")
+        engine.SetThreads(std::max(1, std::min(atoi(value.c_str()), MAX_THREADS)));
+    else if (name == "EvalFile")
+    {
+        if (!value.empty() && value != "<empty>" && !LoadNetwork(value))
+            Send("info string could not load network " + value + ", keeping the current evaluation");
+    }
+    else
+        Send("info string unknown option " + name);
+}
+
+int UciSession::Run()
+{
+    std::thread reader(&UciSession::ReadInput, this);
+
+    while (true)
+    {
+        std::string line;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this]() { return !commands.empty(); });
+            line = commands.front();
+            commands.pop_front();
+        }
+
+        std::istringstream stream(line);
+        std::string command;
+        stream >> command;
+
+        if (command == "uci")
+        {
+            Send("id name Chess-GUI");
+            Send("id author Chess-GUI developers");
+            Send("option name Hash type spin default 16 min 1 max " + std::to_string(MAX_HASH_MB));
+            Send("option name Threads type spin default 1 min 1 max " + std::to_string(MAX_THREADS));
+            Send("option name EvalFile type string default <empty>");
+            Send("uciok");
+        }
+        else if (command == "isready")
+            Send("readyok");
+        else if (command == "ucinewgame")
+        {
+            WaitForSearch();
+            engine.NewGame();
+        }
+        else if (command == "position")
+        {
+            WaitForSearch();
+            HandlePosition(stream);
+        }
+        else if (command == "go")
+            HandleGo(stream);
+        else if (command == "stop")
+        {
+            // Also covers a stop read before its "go" had been started.
+            RequestStop();
+            WaitForSearch();
+        }
+        else if (command == "setoption")
+            HandleSetOption(stream);
+        else if (command == "quit")
+            break;
+        else if (!command.empty())
+            Send("info string unknown command " + command);
+    }
+
+    WaitForSearch();
+    reader.join();
+    return 0;
+}
+
+int RunUci(std::istream& input, std::ostream& output)
+{
+    UciSession session(input, output);
+    return session.Run();
+}
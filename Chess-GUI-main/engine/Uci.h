@@ -0,0 +1,11 @@
+#ifndef UCI_H
+#define UCI_H
+
+#include <iostream>
+
+// Speaks the UCI protocol on the given streams until "quit" or the end of
+// the input, for tournament managers and analysis tools. Input is read on
+// its own thread, so "stop" reaches a running search straight away.
+int RunUci(std::istream& input, std::ostream& output);
+
+#endif
@@ -0,0 +1,91 @@
+#include "AttackMap.h"
+#include "Attacks.h"
+#include <cstring>
+
+AttackMap::AttackMap()
+{
+    memset(attacksFrom, 0, sizeof(attacksFrom));
+    memset(owner, -1, sizeof(owner));
+    memset(counts, 0, sizeof(counts));
+    attacked[0] = attacked[1] = 0;
+}
+
+void AttackMap::AddPiece(const Board& board, int square)
+{
+    bool white = board.IsWhiteAt(square);
+    PieceType type = board.GetTypeAt(square);
+    Bitboard attacks = type == PieceType::PAWN
+        ? GetPawnAttacks(square, white)
+        : GetPieceAttacks(type, square, board.GetOccupied());
+
+    int side = white ? 0 : 1;
+    attacksFrom[square] = attacks;
+    owner[square] = (int8_t)side;
+    while (attacks)
+    {
+        int target = PopLsb(attacks);
+        if (counts[side][target]++ == 0)
+            attacked[side] |= SquareBB(target);
+    }
+}
+
+void AttackMap::RemovePiece(int square)
+{
+    int side = owner[square];
+    Bitboard attacks = attacksFrom[square];
+    while (attacks)
+    {
+        int target = PopLsb(attacks);
+        if (--counts[side][target] == 0)
+            attacked[side] &= ~SquareBB(target);
+    }
+    attacksFrom[square] = 0;
+    owner[square] = -1;
+}
+
+void AttackMap::Compute(const Board& board)
+{
+    *this = AttackMap();
+    Bitboard occupied = board.GetOccupied();
+    while (occupied)
+        AddPiece(board, PopLsb(occupied));
+}
+
+void AttackMap::Update(const Board& before, const Board& after, const BoardMove& move)
+{
+    int from = move.GetFrom();
+    int to = move.GetTo();
+
+    Bitboard changed = SquareBB(from) | SquareBB(to);
+    if (move.IsEnPassant())
+        changed |= SquareBB(to + (before.IsWhiteToMove() ? 8 : -8));
+    else if (move.GetFlags() == MOVE_KING_CASTLE)
+        changed |= SquareBB(from + 3) | SquareBB(from + 1);
+    else if (move.GetFlags() == MOVE_QUEEN_CASTLE)
+        changed |= SquareBB(from - 4) | SquareBB(from - 1);
+
+    // A slider's attacks change only if one of its rays reached a changed
+    // square before or after the move.
+    Bitboard diagonal = after.GetPieces(PieceType::BISHOP, true) | after.GetPieces(PieceType::BISHOP, false)
+        | after.GetPieces(PieceType::QUEEN, true) | after.GetPieces(PieceType::QUEEN, false);
+    Bitboard orthogonal = after.GetPieces(PieceType::ROOK, true) | after.GetPieces(PieceType::ROOK, false)
+        | after.GetPieces(PieceType::QUEEN, true) | after.GetPieces(PieceType::QUEEN, false);
+
+    Bitboard refresh = changed;
+    Bitboard squares = changed;
+    while (squares)
+    {
+        int square = PopLsb(squares);
+        refresh |= (GetBishopAttacks(square, before.GetOccupied()) | GetBishopAttacks(square, after.GetOccupied())) & diagonal;
+        refresh |= (GetRookAttacks(square, before.GetOccupied()) | GetRookAttacks(square, after.GetOccupied())) & orthogonal;
+    }
+
+    while (refresh)
+    {
+        int square = PopLsb(refresh);
+        if (owner[square] >= 0)
+            RemovePiece(square);
+        if (!after.IsEmpty(square))
+            AddPiece(after, square);
+    }
+}
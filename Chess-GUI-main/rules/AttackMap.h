@@ -0,0 +1,31 @@
+#ifndef ATTACK_MAP_H
+#define ATTACK_MAP_H
+
+#include "Board.h"
+
+// Squares attacked by each side, with the number of attackers on every
+// square, kept in step with a board. Update only recomputes the pieces on
+// the squares a move touched and the sliders whose rays pass through them.
+class AttackMap {
+private:
+    Bitboard attacksFrom[NUM_SQUARES];
+    int8_t owner[NUM_SQUARES];
+    uint8_t counts[2][NUM_SQUARES];
+    Bitboard attacked[2];
+
+    void AddPiece(const Board& board, int square);
+    void RemovePiece(int square);
+
+public:
+    AttackMap();
+
+    void Compute(const Board& board);
+    void Update(const Board& before, const Board& after, const BoardMove& move);
+
+    bool IsAttacked(int square, bool byWhite) const { return (attacked[byWhite ? 0 : 1] & SquareBB(square)) != 0; }
+    int GetAttackerCount(int square, bool byWhite) const { return counts[byWhite ? 0 : 1][square]; }
+    Bitboard GetAttacked(bool byWhite) const { return attacked[byWhite ? 0 : 1]; }
+    Bitboard GetAttacksFrom(int square) const { return attacksFrom[square]; }
+};
+
+#endif
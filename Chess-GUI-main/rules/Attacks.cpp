@@ -0,0 +1,212 @@
+#include "Attacks.h"
+#include <cstring>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+
+Bitboard betweenSquares[NUM_SQUARES][NUM_SQUARES];
+Bitboard lineThrough[NUM_SQUARES][NUM_SQUARES];
+Magic rookMagics[NUM_SQUARES];
+Magic bishopMagics[NUM_SQUARES];
+bool usePext = false;
+
+const AttackFunction PIECE_ATTACKS[NUM_PIECE_TYPES] = {
+    nullptr,
+    GetAttacks<PieceType::ROOK>,
+    GetAttacks<PieceType::KNIGHT>,
+    GetAttacks<PieceType::BISHOP>,
+    GetAttacks<PieceType::QUEEN>,
+    GetAttacks<PieceType::KING>
+};
+
+static Bitboard rookTable[0x19000];
+static Bitboard bishopTable[0x1480];
+
+namespace {
+
+struct AttackTablesInit {
+    AttackTablesInit() { InitAttacks(); }
+} attackTablesInit;
+
+const int ROOK_DIRECTIONS[4][2] = {{0, 1}, {1, 0}, {0, -1}, {-1, 0}};
+const int BISHOP_DIRECTIONS[4][2] = {{1, 1}, {1, -1}, {-1, -1}, {-1, 1}};
+
+Bitboard SlidingAttacks(int square, Bitboard occupied, const int directions[4][2])
+{
+    Bitboard attacks = 0;
+    for (int d = 0; d < 4; d++)
+    {
+        int x = SquareX(square) + directions[d][0];
+        int y = SquareY(square) + directions[d][1];
+        while (x >= 0 && x < 8 && y >= 0 && y < 8)
+        {
+            Bitboard bb = SquareBB(SquareOf(x, y));
+            attacks |= bb;
+            if (occupied & bb)
+                break;
+            x += directions[d][0];
+            y += directions[d][1];
+        }
+    }
+    return attacks;
+}
+
+Bitboard EdgesFor(int square)
+{
+    const Bitboard FILE_A = 0x0101010101010101ULL;
+    const Bitboard FILE_H = FILE_A << 7;
+    const Bitboard ROW_0 = 0xFFULL;
+    const Bitboard ROW_7 = ROW_0 << 56;
+
+    Bitboard edges = 0;
+    if (SquareX(square) != 0) edges |= FILE_A;
+    if (SquareX(square) != 7) edges |= FILE_H;
+    if (SquareY(square) != 0) edges |= ROW_0;
+    if (SquareY(square) != 7) edges |= ROW_7;
+    return edges;
+}
+
+// xorshift64*, seeded so that every run finds the same magics.
+struct Prng {
+    uint64_t s;
+    uint64_t Next()
+    {
+        s ^= s >> 12;
+        s ^= s << 25;
+        s ^= s >> 27;
+        return s * 2685821657736338717ULL;
+    }
+    uint64_t Sparse() { return Next() & Next() & Next(); }
+};
+
+void InitMagics(Magic magics[], Bitboard table[], const int directions[4][2])
+{
+    static Bitboard occupancy[4096];
+    static Bitboard reference[4096];
+    static int epoch[4096];
+    int currentEpoch = 0;
+    Prng rng = {728};
+
+    Bitboard* next = table;
+    for (int square = 0; square < NUM_SQUARES; square++)
+    {
+        Magic& m = magics[square];
+        m.mask = SlidingAttacks(square, 0, directions) & ~EdgesFor(square);
+        m.shift = 64 - PopCount(m.mask);
+        m.attacks = next;
+
+        int size = 0;
+        Bitboard subset = 0;
+        do
+        {
+            occupancy[size] = subset;
+            reference[size] = SlidingAttacks(square, subset, directions);
+            size++;
+            subset = (subset - m.mask) & m.mask;
+        } while (subset);
+        next += size;
+
+        if (usePext)
+        {
+            m.magic = 0;
+            for (int i = 0; i < size; i++)
+                m.attacks[PextIndex(occupancy[i], m.mask)] = reference[i];
+            continue;
+        }
+
+        for (int i = 0; i < size;)
+        {
+            do
+                m.magic = rng.Sparse();
+            while (PopCount((m.magic * m.mask) >> 56) < 6);
+
+            currentEpoch++;
+            for (i = 0; i < size; i++)
+            {
+                unsigned index = MagicIndex(m, occupancy[i]);
+                if (epoch[index] < currentEpoch)
+                {
+                    epoch[index] = currentEpoch;
+                    m.attacks[index] = reference[i];
+                }
+                else if (m.attacks[index] != reference[i])
+                {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+}
+
+bool CpuHasPext()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 8)) != 0;
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_cpu_supports("bmi2");
+#else
+    return false;
+#endif
+}
+
+#if !defined(__BMI2__)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+__attribute__((target("bmi2")))
+#endif
+unsigned PextIndex(Bitboard occupied, Bitboard mask)
+{
+#if defined(_M_X64) || defined(__x86_64__)
+    return (unsigned)_pext_u64(occupied, mask);
+#elif defined(_M_IX86) || defined(__i386__)
+    unsigned low = _pext_u32((unsigned)occupied, (unsigned)mask);
+    unsigned high = _pext_u32((unsigned)(occupied >> 32), (unsigned)(mask >> 32));
+    return low | (high << PopCount(mask & 0xFFFFFFFFULL));
+#else
+    unsigned index = 0;
+    for (int bit = 0; mask; bit++)
+    {
+        if (occupied & mask & (0 - mask))
+            index |= 1u << bit;
+        mask &= mask - 1;
+    }
+    return index;
+#endif
+}
+#endif
+
+void InitAttacks()
+{
+    static bool initialized = false;
+    if (initialized)
+        return;
+    initialized = true;
+
+    usePext = CpuHasPext();
+    InitMagics(rookMagics, rookTable, ROOK_DIRECTIONS);
+    InitMagics(bishopMagics, bishopTable, BISHOP_DIRECTIONS);
+
+    for (int from = 0; from < NUM_SQUARES; from++)
+    {
+        for (int to = 0; to < NUM_SQUARES; to++)
+        {
+            Bitboard ends = SquareBB(from) | SquareBB(to);
+            if (GetRookAttacks(from, 0) & SquareBB(to))
+            {
+                betweenSquares[from][to] = GetRookAttacks(from, SquareBB(to)) & GetRookAttacks(to, SquareBB(from));
+                lineThrough[from][to] = (GetRookAttacks(from, 0) & GetRookAttacks(to, 0)) | ends;
+            }
+            else if (GetBishopAttacks(from, 0) & SquareBB(to))
+            {
+                betweenSquares[from][to] = GetBishopAttacks(from, SquareBB(to)) & GetBishopAttacks(to, SquareBB(from));
+                lineThrough[from][to] = (GetBishopAttacks(from, 0) & GetBishopAttacks(to, 0)) | ends;
+            }
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef ATTACKS_H
+#define ATTACKS_H
+
+#include "Board.h"
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// Sliding attacks come from tables indexed by the relevant blockers on the
+// piece's rays. The index is a magic multiply, or BMI2 PEXT when the CPU has it.
+struct Magic {
+    Bitboard mask;
+    Bitboard magic;
+    Bitboard* attacks;
+    int shift;
+};
+
+// Knight, king and pawn attacks depend only on the square, so the tables are
+// built by the compiler.
+struct SquareTable {
+    Bitboard squares[NUM_SQUARES];
+};
+
+constexpr int KNIGHT_STEPS[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+constexpr int KING_STEPS[8][2] = {{0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}};
+constexpr int PAWN_STEPS[2][2][2] = {{{-1, -1}, {1, -1}}, {{-1, 1}, {1, 1}}};
+
+constexpr SquareTable MakeStepTable(const int steps[][2], int count)
+{
+    SquareTable table = {};
+    for (int square = 0; square < NUM_SQUARES; square++)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            int x = SquareX(square) + steps[i][0];
+            int y = SquareY(square) + steps[i][1];
+            if (x >= 0 && x < 8 && y >= 0 && y < 8)
+                table.squares[square] |= SquareBB(SquareOf(x, y));
+        }
+    }
+    return table;
+}
+
+inline constexpr SquareTable KNIGHT_ATTACKS = MakeStepTable(KNIGHT_STEPS, 8);
+inline constexpr SquareTable KING_ATTACKS = MakeStepTable(KING_STEPS, 8);
+inline constexpr SquareTable PAWN_ATTACKS[2] = {MakeStepTable(PAWN_STEPS[SIDE_WHITE], 2), MakeStepTable(PAWN_STEPS[SIDE_BLACK], 2)};
+
+static_assert(KNIGHT_ATTACKS.squares[0] == (SquareBB(10) | SquareBB(17)), "knight table");
+static_assert(PAWN_ATTACKS[SIDE_WHITE].squares[SquareOf(4, 6)] == (SquareBB(SquareOf(3, 5)) | SquareBB(SquareOf(5, 5))), "pawn table");
+
+extern Bitboard betweenSquares[NUM_SQUARES][NUM_SQUARES];
+extern Bitboard lineThrough[NUM_SQUARES][NUM_SQUARES];
+extern Magic rookMagics[NUM_SQUARES];
+extern Magic bishopMagics[NUM_SQUARES];
+extern bool usePext;
+
+void InitAttacks();
+bool CpuHasPext();
+
+#if defined(__BMI2__)
+inline unsigned PextIndex(Bitboard occupied, Bitboard mask) { return (unsigned)_pext_u64(occupied, mask); }
+#else
+unsigned PextIndex(Bitboard occupied, Bitboard mask);
+#endif
+
+inline unsigned MagicIndex(const Magic& m, Bitboard occupied) {
+    if (usePext)
+        return PextIndex(occupied, m.mask);
+    return (unsigned)(((occupied & m.mask) * m.magic) >> m.shift);
+}
+
+inline Bitboard GetRookAttacks(int square, Bitboard occupied) {
+    const Magic& m = rookMagics[square];
+    return m.attacks[MagicIndex(m, occupied)];
+}
+
+inline Bitboard GetBishopAttacks(int square, Bitboard occupied) {
+    const Magic& m = bishopMagics[square];
+    return m.attacks[MagicIndex(m, occupied)];
+}
+
+inline Bitboard GetQueenAttacks(int square, Bitboard occupied) {
+    return GetRookAttacks(square, occupied) | GetBishopAttacks(square, occupied);
+}
+
+inline Bitboard GetKnightAttacks(int square) { return KNIGHT_ATTACKS.squares[square]; }
+inline Bitboard GetKingAttacks(int square) { return KING_ATTACKS.squares[square]; }
+inline Bitboard GetPawnAttacks(int square, bool isWhite) { return PAWN_ATTACKS[isWhite ? SIDE_WHITE : SIDE_BLACK].squares[square]; }
+
+template<Side Us>
+inline Bitboard GetPawnAttacks(int square) { return PAWN_ATTACKS[Us].squares[square]; }
+
+// Attacks of a non-pawn piece with its type known at compile time, for the
+// generator's per-type loops.
+template<PieceType Type> Bitboard GetAttacks(int square, Bitboard occupied);
+template<> inline Bitboard GetAttacks<PieceType::KNIGHT>(int square, Bitboard) { return GetKnightAttacks(square); }
+template<> inline Bitboard GetAttacks<PieceType::BISHOP>(int square, Bitboard occupied) { return GetBishopAttacks(square, occupied); }
+template<> inline Bitboard GetAttacks<PieceType::ROOK>(int square, Bitboard occupied) { return GetRookAttacks(square, occupied); }
+template<> inline Bitboard GetAttacks<PieceType::QUEEN>(int square, Bitboard occupied) { return GetQueenAttacks(square, occupied); }
+template<> inline Bitboard GetAttacks<PieceType::KING>(int square, Bitboard) { return GetKingAttacks(square); }
+
+// The same attacks with the type known only at run time, looked up in a
+// flat table indexed by PieceType. Pawns need a side and are not included.
+typedef Bitboard (*AttackFunction)(int square, Bitboard occupied);
+extern const AttackFunction PIECE_ATTACKS[NUM_PIECE_TYPES];
+
+inline Bitboard GetPieceAttacks(PieceType type, int square, Bitboard occupied) { return PIECE_ATTACKS[(int)type](square, occupied); }
+
+// Squares strictly between two aligned squares, and the full line through
+// them. Both are empty when the squares share no rank, file or diagonal.
+inline Bitboard GetBetween(int from, int to) { return betweenSquares[from][to]; }
+inline Bitboard GetLine(int from, int to) { return lineThrough[from][to]; }
+
+#endif
@@ -0,0 +1,271 @@
+#include "Board.h"
+#include "Attacks.h"
+#include "PieceSquare.h"
+#include "Zobrist.h"
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+// Rights that survive a move touching each square; a8 and h8 hold black's
+// rooks, e8 its king, and likewise a1, h1 and e1 for white.
+uint8_t CastlingMaskFor(int square)
+{
+    switch (square)
+    {
+    case 0: return (uint8_t)~BLACK_QUEENSIDE;
+    case 4: return (uint8_t)~(BLACK_KINGSIDE | BLACK_QUEENSIDE);
+    case 7: return (uint8_t)~BLACK_KINGSIDE;
+    case 56: return (uint8_t)~WHITE_QUEENSIDE;
+    case 60: return (uint8_t)~(WHITE_KINGSIDE | WHITE_QUEENSIDE);
+    case 63: return (uint8_t)~WHITE_KINGSIDE;
+    default: return 0xFF;
+    }
+}
+
+}
+
+Board::Board()
+{
+    Clear();
+}
+
+void Board::Clear()
+{
+    memset(pieces, 0, sizeof(pieces));
+    memset(sides, 0, sizeof(sides));
+    occupied = 0;
+    memset(mailbox, NO_PIECE, sizeof(mailbox));
+    whiteToMove = true;
+    enPassantSquare = NO_SQUARE;
+    castlingRights = 0;
+    halfmoveClock = 0;
+    key = 0;
+    pawnKey = 0;
+    phase = 0;
+    midgame = 0;
+    endgame = 0;
+}
+
+void Board::Reset()
+{
+    const PieceType backRank[8] = {
+        PieceType::ROOK, PieceType::KNIGHT, PieceType::BISHOP, PieceType::QUEEN,
+        PieceType::KING, PieceType::BISHOP, PieceType::KNIGHT, PieceType::ROOK
+    };
+
+    Clear();
+    for (int x = 0; x < 8; x++)
+    {
+        AddPiece(SquareOf(x, 0), backRank[x], false);
+        AddPiece(SquareOf(x, 1), PieceType::PAWN, false);
+        AddPiece(SquareOf(x, 6), PieceType::PAWN, true);
+        AddPiece(SquareOf(x, 7), backRank[x], true);
+    }
+    castlingRights = WHITE_KINGSIDE | WHITE_QUEENSIDE | BLACK_KINGSIDE | BLACK_QUEENSIDE;
+    key = ComputeKey();
+}
+
+bool Board::SetFen(const std::string& fen)
+{
+    std::istringstream stream(fen);
+    std::string placement, side, castling, enPassant;
+    int halfmoves = 0;
+
+    if (!(stream >> placement >> side))
+        return false;
+    stream >> castling >> enPassant >> halfmoves;
+
+    Clear();
+    int square = 0;
+    for (char c : placement)
+    {
+        if (c == '/')
+            continue;
+        if (c >= '1' && c <= '8')
+        {
+            square += c - '0';
+            continue;
+        }
+
+        const char* types = "prnbqk";
+        const char* found = strchr(types, c | 0x20);
+        if (!found || square >= NUM_SQUARES)
+            return false;
+        AddPiece(square++, (PieceType)(found - types), c < 'a');
+    }
+    if (square != NUM_SQUARES)
+        return false;
+
+    whiteToMove = side == "w";
+    for (char c : castling)
+    {
+        switch (c)
+        {
+        case 'K': castlingRights |= WHITE_KINGSIDE; break;
+        case 'Q': castlingRights |= WHITE_QUEENSIDE; break;
+        case 'k': castlingRights |= BLACK_KINGSIDE; break;
+        case 'q': castlingRights |= BLACK_QUEENSIDE; break;
+        }
+    }
+    if (enPassant.size() == 2 && enPassant[0] >= 'a' && enPassant[0] <= 'h' && enPassant[1] >= '1' && enPassant[1] <= '8')
+    {
+        int epSquare = SquareOf(enPassant[0] - 'a', '8' - enPassant[1]);
+        if (GetPawnAttacks(epSquare, !whiteToMove) & GetPieces(PieceType::PAWN, whiteToMove))
+            enPassantSquare = (int8_t)epSquare;
+    }
+    halfmoveClock = (uint16_t)halfmoves;
+    key = ComputeKey();
+    return true;
+}
+
+void Board::AddPiece(int square, PieceType type, bool isWhite)
+{
+    int side = SideIndex(isWhite);
+    Bitboard bb = SquareBB(square);
+
+    pieces[side][(int)type] |= bb;
+    sides[side] |= bb;
+    occupied |= bb;
+    mailbox[square] = (int8_t)(side * NUM_PIECE_TYPES + (int)type);
+    key ^= GetPieceKey(mailbox[square], square);
+    if (type == PieceType::PAWN)
+        pawnKey ^= GetPieceKey(mailbox[square], square);
+    midgame += GetMidgameValue(mailbox[square], square);
+    endgame += GetEndgameValue(mailbox[square], square);
+    phase += PHASE_WEIGHTS[(int)type];
+}
+
+void Board::RemovePiece(int square)
+{
+    if (IsEmpty(square))
+        return;
+
+    int side = mailbox[square] / NUM_PIECE_TYPES;
+    int type = mailbox[square] % NUM_PIECE_TYPES;
+    Bitboard bb = SquareBB(square);
+
+    pieces[side][type] &= ~bb;
+    sides[side] &= ~bb;
+    occupied &= ~bb;
+    key ^= GetPieceKey(mailbox[square], square);
+    if (type == (int)PieceType::PAWN)
+        pawnKey ^= GetPieceKey(mailbox[square], square);
+    midgame -= GetMidgameValue(mailbox[square], square);
+    endgame -= GetEndgameValue(mailbox[square], square);
+    phase -= PHASE_WEIGHTS[type];
+    mailbox[square] = NO_PIECE;
+}
+
+void Board::MovePiece(int from, int to)
+{
+    if (IsEmpty(from) || from == to)
+        return;
+    if (!IsEmpty(to))
+        RemovePiece(to);
+
+    int side = mailbox[from] / NUM_PIECE_TYPES;
+    int type = mailbox[from] % NUM_PIECE_TYPES;
+    Bitboard fromTo = SquareBB(from) | SquareBB(to);
+
+    pieces[side][type] ^= fromTo;
+    sides[side] ^= fromTo;
+    occupied ^= fromTo;
+    key ^= GetPieceKey(mailbox[from], from) ^ GetPieceKey(mailbox[from], to);
+    if (type == (int)PieceType::PAWN)
+        pawnKey ^= GetPieceKey(mailbox[from], from) ^ GetPieceKey(mailbox[from], to);
+    midgame += GetMidgameValue(mailbox[from], to) - GetMidgameValue(mailbox[from], from);
+    endgame += GetEndgameValue(mailbox[from], to) - GetEndgameValue(mailbox[from], from);
+    mailbox[to] = mailbox[from];
+    mailbox[from] = NO_PIECE;
+}
+
+void Board::MakeMove(const BoardMove& move)
+{
+    int from = move.GetFrom();
+    int to = move.GetTo();
+    bool resetsClock = move.IsCapture() || GetTypeAt(from) == PieceType::PAWN;
+
+    key ^= GetCastlingKey(castlingRights);
+    if (enPassantSquare != NO_SQUARE)
+        key ^= GetEnPassantKey(enPassantSquare);
+
+    if (move.IsEnPassant())
+        RemovePiece(to + (whiteToMove ? 8 : -8));
+
+    MovePiece(from, to);
+
+    if (move.IsPromotion())
+    {
+        RemovePiece(to);
+        AddPiece(to, move.GetPromotion(), whiteToMove);
+    }
+
+    if (move.IsCastle())
+    {
+        bool kingside = move.GetFlags() == MOVE_KING_CASTLE;
+        MovePiece(kingside ? from + 3 : from - 4, kingside ? from + 1 : from - 1);
+    }
+
+    castlingRights &= CastlingMaskFor(from) & CastlingMaskFor(to);
+    key ^= GetCastlingKey(castlingRights);
+
+    // The en passant square is only recorded when a pawn can take on it, so
+    // that repetitions are not hidden by a capture nobody can make.
+    enPassantSquare = NO_SQUARE;
+    if (move.IsDoublePush())
+    {
+        int passed = (from + to) / 2;
+        if (GetPawnAttacks(passed, whiteToMove) & GetPieces(PieceType::PAWN, !whiteToMove))
+        {
+            enPassantSquare = (int8_t)passed;
+            key ^= GetEnPassantKey(passed);
+        }
+    }
+
+    halfmoveClock = resetsClock ? 0 : (uint16_t)(halfmoveClock + 1);
+    whiteToMove = !whiteToMove;
+    key ^= GetSideKey();
+}
+
+uint64_t Board::ComputeKey() const
+{
+    uint64_t computed = GetCastlingKey(castlingRights);
+    for (int square = 0; square < NUM_SQUARES; square++)
+    {
+        if (!IsEmpty(square))
+            computed ^= GetPieceKey(mailbox[square], square);
+    }
+    if (enPassantSquare != NO_SQUARE)
+        computed ^= GetEnPassantKey(enPassantSquare);
+    if (!whiteToMove)
+        computed ^= GetSideKey();
+    return computed;
+}
+
+Board Board::Apply(const BoardMove& move) const
+{
+    Board after = *this;
+    after.MakeMove(move);
+    return after;
+}
+
+// Passes the turn for null-move pruning. The halfmove clock restarts so
+// that repetition checks do not look back across the null move.
+Board Board::ApplyNullMove() const
+{
+    Board after = *this;
+    if (after.enPassantSquare != NO_SQUARE)
+        after.key ^= GetEnPassantKey(after.enPassantSquare);
+    after.enPassantSquare = NO_SQUARE;
+    after.halfmoveClock = 0;
+    after.whiteToMove = !whiteToMove;
+    after.key ^= GetSideKey();
+    return after;
+}
+
+int Board::GetKingSquare(bool isWhite) const
+{
+    Bitboard king = GetPieces(PieceType::KING, isWhite);
+    return king ? Lsb(king) : NO_SQUARE;
+}
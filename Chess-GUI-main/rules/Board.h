@@ -0,0 +1,76 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "Types.h"
+#include "BoardMove.h"
+#include <string>
+
+enum CastlingRight : uint8_t {
+    WHITE_KINGSIDE = 1,
+    WHITE_QUEENSIDE = 2,
+    BLACK_KINGSIDE = 4,
+    BLACK_QUEENSIDE = 8
+};
+
+// A position as a plain value: four cache lines, no pointers, so copying it
+// is cheap and a copy can be read from any thread while the original moves
+// on. Apply returns the position after a move and leaves this one untouched.
+class alignas(64) Board {
+private:
+    Bitboard pieces[2][NUM_PIECE_TYPES];
+    Bitboard sides[2];
+    Bitboard occupied;
+    uint64_t key;
+    uint64_t pawnKey;
+    int8_t mailbox[NUM_SQUARES];
+    int8_t enPassantSquare;
+    uint8_t castlingRights;
+    uint16_t halfmoveClock;
+    bool whiteToMove;
+    uint8_t phase;
+    int16_t midgame;
+    int16_t endgame;
+
+    static int SideIndex(bool isWhite) { return isWhite ? 0 : 1; }
+
+public:
+    Board();
+
+    void Clear();
+    void Reset();
+    bool SetFen(const std::string& fen);
+    void MakeMove(const BoardMove& move);
+    Board Apply(const BoardMove& move) const;
+    Board ApplyNullMove() const;
+    void AddPiece(int square, PieceType type, bool isWhite);
+    void RemovePiece(int square);
+    void MovePiece(int from, int to);
+    uint64_t ComputeKey() const;
+
+    bool IsEmpty(int square) const { return mailbox[square] == NO_PIECE; }
+    PieceType GetTypeAt(int square) const { return static_cast<PieceType>(mailbox[square] % NUM_PIECE_TYPES); }
+    bool IsWhiteAt(int square) const { return mailbox[square] < NUM_PIECE_TYPES; }
+
+    Bitboard GetPieces(PieceType type, bool isWhite) const { return pieces[SideIndex(isWhite)][(int)type]; }
+    Bitboard GetSide(bool isWhite) const { return sides[SideIndex(isWhite)]; }
+    Bitboard GetOccupied() const { return occupied; }
+    int GetKingSquare(bool isWhite) const;
+    bool IsWhiteToMove() const { return whiteToMove; }
+    int GetEnPassantSquare() const { return enPassantSquare; }
+    uint8_t GetCastlingRights() const { return castlingRights; }
+    int GetHalfmoveClock() const { return halfmoveClock; }
+    uint64_t GetKey() const { return key; }
+
+    // Zobrist key of the pawns alone, for caching pawn-structure terms.
+    uint64_t GetPawnKey() const { return pawnKey; }
+
+    // Running material and piece-square totals, white minus black, kept up
+    // to date by AddPiece, RemovePiece and MovePiece.
+    int GetMidgameScore() const { return midgame; }
+    int GetEndgameScore() const { return endgame; }
+    int GetPhase() const { return phase; }
+};
+
+static_assert(sizeof(Board) == 256, "Board should stay four cache lines");
+
+#endif
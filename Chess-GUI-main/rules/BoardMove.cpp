@@ -0,0 +1,40 @@
+#include "BoardMove.h"
+
+namespace {
+
+const PieceType PROMOTION_TYPES[4] = {PieceType::KNIGHT, PieceType::BISHOP, PieceType::ROOK, PieceType::QUEEN};
+
+}
+
+BoardMove::BoardMove(int from, int to, PieceType promotion, bool capture)
+{
+    int code = 3;
+    for (int i = 0; i < 4; i++)
+    {
+        if (PROMOTION_TYPES[i] == promotion)
+            code = i;
+    }
+    int flags = MOVE_PROMOTION | (capture ? MOVE_CAPTURE : 0) | code;
+    data = (uint16_t)(from | (to << 6) | (flags << 12));
+}
+
+PieceType BoardMove::GetPromotion() const
+{
+    return IsPromotion() ? PROMOTION_TYPES[GetFlags() & 3] : PieceType::PAWN;
+}
+
+std::string SquareName(int square)
+{
+    std::string name;
+    name += (char)('a' + SquareX(square));
+    name += (char)('8' - SquareY(square));
+    return name;
+}
+
+std::string MoveToString(const BoardMove& move)
+{
+    std::string text = SquareName(move.GetFrom()) + SquareName(move.GetTo());
+    if (move.IsPromotion())
+        text += "prnbqk"[(int)move.GetPromotion()];
+    return text;
+}
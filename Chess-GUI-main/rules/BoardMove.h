@@ -0,0 +1,73 @@
+#ifndef BOARD_MOVE_H
+#define BOARD_MOVE_H
+
+#include "Types.h"
+#include <string>
+
+// Four flag bits on top of the from and to squares. Bit 2 marks captures
+// and bit 3 promotions, whose low two bits then select the new piece.
+enum MoveFlag : uint8_t {
+    MOVE_QUIET = 0,
+    MOVE_DOUBLE_PUSH = 1,
+    MOVE_KING_CASTLE = 2,
+    MOVE_QUEEN_CASTLE = 3,
+    MOVE_CAPTURE = 4,
+    MOVE_EN_PASSANT = 5,
+    MOVE_PROMOTION = 8
+};
+
+class BoardMove {
+private:
+    uint16_t data;
+
+public:
+    BoardMove() : data(0) {}
+    BoardMove(int from, int to, int flags = MOVE_QUIET)
+        : data((uint16_t)(from | (to << 6) | (flags << 12))) {}
+    BoardMove(int from, int to, PieceType promotion, bool capture);
+
+    int GetFrom() const { return data & 63; }
+    int GetTo() const { return (data >> 6) & 63; }
+    int GetFlags() const { return data >> 12; }
+    uint16_t GetData() const { return data; }
+    PieceType GetPromotion() const;
+    BoardMove WithPromotion(PieceType type) const { return BoardMove(GetFrom(), GetTo(), type, IsCapture()); }
+
+    bool IsNull() const { return data == 0; }
+    bool IsCapture() const { return (GetFlags() & MOVE_CAPTURE) != 0; }
+    bool IsPromotion() const { return (GetFlags() & MOVE_PROMOTION) != 0; }
+    bool IsEnPassant() const { return GetFlags() == MOVE_EN_PASSANT; }
+    bool IsDoublePush() const { return GetFlags() == MOVE_DOUBLE_PUSH; }
+    bool IsCastle() const { return GetFlags() == MOVE_KING_CASTLE || GetFlags() == MOVE_QUEEN_CASTLE; }
+
+    bool operator==(const BoardMove& other) const { return data == other.data; }
+    bool operator!=(const BoardMove& other) const { return data != other.data; }
+};
+
+const int MAX_MOVES = 256;
+
+// Fixed-capacity move buffer that lives on the stack of the generator's caller.
+class MoveList {
+private:
+    BoardMove moves[MAX_MOVES];
+    int count;
+
+public:
+    MoveList() : count(0) {}
+
+    void Add(BoardMove move) { moves[count++] = move; }
+    void Clear() { count = 0; }
+    int Size() const { return count; }
+    bool IsEmpty() const { return count == 0; }
+
+    BoardMove& operator[](int index) { return moves[index]; }
+    const BoardMove& operator[](int index) const { return moves[index]; }
+    BoardMove* begin() { return moves; }
+    BoardMove* end() { return moves + count; }
+    const BoardMove* begin() const { return moves; }
+    const BoardMove* end() const { return moves + count; }
+};
+
+std::string MoveToString(const BoardMove& move);
+
+#endif
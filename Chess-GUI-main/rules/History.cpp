@@ -0,0 +1,21 @@
+#include "History.h"
+
+// Only positions since the last capture or pawn move can repeat, and only
+// those with the same side to move, so the scan steps back two plies at a
+// time and stops at the halfmove clock.
+int PositionHistory::CountRepetitions(const Board& board) const
+{
+    uint64_t key = board.GetKey();
+    int size = (int)keys.size();
+    int oldest = size - board.GetHalfmoveClock();
+    if (oldest < 0)
+        oldest = 0;
+
+    int count = 0;
+    for (int i = size - 2; i >= oldest; i -= 2)
+    {
+        if (keys[i] == key)
+            count++;
+    }
+    return count;
+}
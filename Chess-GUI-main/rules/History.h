@@ -0,0 +1,24 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include "Board.h"
+#include <vector>
+
+// Keys of the positions played so far, oldest first, not counting the
+// current one. Push the key before making a move and pop it on unmake.
+class PositionHistory {
+private:
+    std::vector<uint64_t> keys;
+
+public:
+    void Clear() { keys.clear(); }
+    void Push(uint64_t key) { keys.push_back(key); }
+    void Pop() { keys.pop_back(); }
+    int Size() const { return (int)keys.size(); }
+
+    int CountRepetitions(const Board& board) const;
+    bool IsRepetition(const Board& board) const { return CountRepetitions(board) > 0; }
+    bool IsThreefoldRepetition(const Board& board) const { return CountRepetitions(board) >= 2; }
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "Perft.h"
+#include "Rules.h"
+#include "ThreadPool.h"
+
+namespace {
+
+// Collects the positions splitDepth plies below board, tagged with the root
+// move that leads to each.
+void CollectTasks(const Board& board, int splitDepth, int rootIndex, std::vector<Board>& tasks, std::vector<int>& roots)
+{
+    if (splitDepth == 0)
+    {
+        tasks.push_back(board);
+        roots.push_back(rootIndex);
+        return;
+    }
+
+    MoveList moves;
+    GenerateLegalMoves(board, moves);
+    for (int i = 0; i < moves.Size(); i++)
+    {
+        Board after = board.Apply(moves[i]);
+        CollectTasks(after, splitDepth - 1, rootIndex < 0 ? i : rootIndex, tasks, roots);
+    }
+}
+
+}
+
+uint64_t Perft(const Board& board, int depth)
+{
+    MoveList moves;
+    GenerateLegalMoves(board, moves);
+
+    if (depth <= 1)
+        return depth == 1 ? (uint64_t)moves.Size() : 1;
+
+    uint64_t nodes = 0;
+    for (const BoardMove& move : moves)
+    {
+        Board after = board.Apply(move);
+        nodes += Perft(after, depth - 1);
+    }
+    return nodes;
+}
+
+std::vector<PerftDivide> PerftDivided(const Board& board, int depth)
+{
+    MoveList moves;
+    GenerateLegalMoves(board, moves);
+
+    std::vector<PerftDivide> divide;
+    for (const BoardMove& move : moves)
+    {
+        Board after = board.Apply(move);
+        divide.push_back({move, Perft(after, depth - 1)});
+    }
+    return divide;
+}
+
+std::vector<PerftDivide> ParallelPerftDivided(const Board& board, int depth, int threads, int splitDepth)
+{
+    if (splitDepth > depth - 1)
+        splitDepth = depth - 1;
+    if (threads <= 1 || splitDepth < 1)
+        return PerftDivided(board, depth);
+
+    MoveList moves;
+    GenerateLegalMoves(board, moves);
+
+    std::vector<Board> tasks;
+    std::vector<int> roots;
+    CollectTasks(board, splitDepth, -1, tasks, roots);
+
+    // Each worker counts into its own row, merged once the pool is done.
+    WorkStealingPool pool(threads);
+    std::vector<std::vector<uint64_t>> counters(threads, std::vector<uint64_t>(moves.Size()));
+    pool.Run((int)tasks.size(), [&](int task, int worker) {
+        counters[worker][roots[task]] += Perft(tasks[task], depth - splitDepth);
+    });
+
+    std::vector<PerftDivide> divide;
+    for (int i = 0; i < moves.Size(); i++)
+    {
+        uint64_t nodes = 0;
+        for (int worker = 0; worker < threads; worker++)
+            nodes += counters[worker][i];
+        divide.push_back({moves[i], nodes});
+    }
+    return divide;
+}
+
+uint64_t ParallelPerft(const Board& board, int depth, int threads, int splitDepth)
+{
+    if (threads <= 1 || depth < 2)
+        return Perft(board, depth);
+
+    uint64_t nodes = 0;
+    for (const PerftDivide& entry : ParallelPerftDivided(board, depth, threads, splitDepth))
+        nodes += entry.nodes;
+    return nodes;
+}
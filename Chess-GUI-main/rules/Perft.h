@@ -0,0 +1,21 @@
+#ifndef PERFT_H
+#define PERFT_H
+
+#include "Board.h"
+#include <cstdint>
+#include <vector>
+
+struct PerftDivide {
+    BoardMove move;
+    uint64_t nodes;
+};
+
+uint64_t Perft(const Board& board, int depth);
+std::vector<PerftDivide> PerftDivided(const Board& board, int depth);
+
+// Expands the tree splitDepth plies deep and counts the subtrees below on a
+// work-stealing pool; gives the same totals as Perft.
+uint64_t ParallelPerft(const Board& board, int depth, int threads, int splitDepth = 2);
+std::vector<PerftDivide> ParallelPerftDivided(const Board& board, int depth, int threads, int splitDepth = 2);
+
+#endif
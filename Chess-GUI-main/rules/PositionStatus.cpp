@@ -0,0 +1,50 @@
+#include "PositionStatus.h"
+
+PositionStatus::PositionStatus() : checkedKing(NO_SQUARE), result(GameResult::ONGOING), key(0)
+{
+    for (int& start : moveStart)
+        start = 0;
+}
+
+void PositionStatus::Update(const Board& board)
+{
+    MoveList generated;
+    GenerateLegalMoves(board, generated);
+
+    int counts[NUM_SQUARES] = {};
+    for (const BoardMove& move : generated)
+        counts[move.GetFrom()]++;
+
+    moveStart[0] = 0;
+    for (int square = 0; square < NUM_SQUARES; square++)
+        moveStart[square + 1] = moveStart[square] + counts[square];
+
+    int next[NUM_SQUARES];
+    for (int square = 0; square < NUM_SQUARES; square++)
+        next[square] = moveStart[square];
+
+    moves = generated;
+    for (const BoardMove& move : generated)
+        moves[next[move.GetFrom()]++] = move;
+
+    bool inCheck = ::IsInCheck(board);
+    checkedKing = inCheck ? board.GetKingSquare(board.IsWhiteToMove()) : NO_SQUARE;
+
+    if (moves.IsEmpty())
+        result = inCheck ? GameResult::CHECKMATE : GameResult::STALEMATE;
+    else
+        result = IsFiftyMoveDraw(board) ? GameResult::DRAW_FIFTY_MOVES : GameResult::ONGOING;
+    key = board.GetKey();
+}
+
+void PositionStatus::Update(const Board& board, const PositionHistory& history)
+{
+    Update(board);
+    if (result == GameResult::ONGOING && history.IsThreefoldRepetition(board))
+        result = GameResult::DRAW_REPETITION;
+}
+
+std::vector<BoardMove> PositionStatus::GetMovesFrom(int square) const
+{
+    return std::vector<BoardMove>(moves.begin() + moveStart[square], moves.begin() + moveStart[square + 1]);
+}
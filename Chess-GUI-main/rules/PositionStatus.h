@@ -0,0 +1,37 @@
+#ifndef POSITION_STATUS_H
+#define POSITION_STATUS_H
+
+#include "Board.h"
+#include "Rules.h"
+#include "History.h"
+#include <vector>
+
+// Everything the GUI asks about a position between two moves: the legal
+// moves grouped by origin square, whether the side to move is in check, and
+// whether the game is over. Rebuild it with Update after every move; pass
+// the game history to also detect threefold repetition.
+class PositionStatus {
+private:
+    MoveList moves;
+    int moveStart[NUM_SQUARES + 1];
+    int checkedKing;
+    GameResult result;
+    uint64_t key;
+
+public:
+    PositionStatus();
+
+    void Update(const Board& board);
+    void Update(const Board& board, const PositionHistory& history);
+
+    std::vector<BoardMove> GetMovesFrom(int square) const;
+    const MoveList& GetAllMoves() const { return moves; }
+    bool HasMovesFrom(int square) const { return moveStart[square + 1] > moveStart[square]; }
+    bool IsInCheck() const { return checkedKing != NO_SQUARE; }
+    int GetCheckedKing() const { return checkedKing; }
+    GameResult GetResult() const { return result; }
+    bool IsDraw() const { return result != GameResult::ONGOING && result != GameResult::CHECKMATE; }
+    uint64_t GetKey() const { return key; }
+};
+
+#endif
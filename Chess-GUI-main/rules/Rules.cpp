@@ -0,0 +1,311 @@
+#include "Rules.h"
+#include "Attacks.h"
+
+namespace {
+
+void AddMoves(MoveList& moves, int from, Bitboard targets, Bitboard enemies)
+{
+    while (targets)
+    {
+        int to = PopLsb(targets);
+        moves.Add(BoardMove(from, to, (enemies & SquareBB(to)) ? MOVE_CAPTURE : MOVE_QUIET));
+    }
+}
+
+void AddPawnMove(MoveList& moves, int from, int to, int flags)
+{
+    if (SquareY(to) == 0 || SquareY(to) == 7)
+    {
+        const PieceType promotions[4] = {PieceType::QUEEN, PieceType::ROOK, PieceType::BISHOP, PieceType::KNIGHT};
+        for (PieceType type : promotions)
+            moves.Add(BoardMove(from, to, type, flags == MOVE_CAPTURE));
+        return;
+    }
+    moves.Add(BoardMove(from, to, flags));
+}
+
+// The side is a template parameter so that pawn directions, start ranks and
+// castling squares fold into constants. Pushes to the last rank count as
+// noisy along with captures.
+template<Side Us, bool Legal, MoveGenType Gen>
+void GeneratePawnMoves(const Board& board, MoveList& moves, int from, Bitboard allowed)
+{
+    constexpr bool white = Us == SIDE_WHITE;
+    constexpr int forward = white ? -8 : 8;
+    constexpr int startY = white ? 6 : 1;
+    constexpr int promotionY = white ? 0 : 7;
+    Bitboard occupied = board.GetOccupied();
+
+    int to = from + forward;
+    if (!(occupied & SquareBB(to)))
+    {
+        bool promotes = SquareY(to) == promotionY;
+        if ((allowed & SquareBB(to)) && (Gen == GEN_ALL || (Gen == GEN_NOISY) == promotes))
+            AddPawnMove(moves, from, to, MOVE_QUIET);
+        if (Gen != GEN_NOISY && SquareY(from) == startY && !(occupied & SquareBB(to + forward)) && (allowed & SquareBB(to + forward)))
+            moves.Add(BoardMove(from, to + forward, MOVE_DOUBLE_PUSH));
+    }
+
+    if (Gen == GEN_QUIET)
+        return;
+
+    Bitboard attacks = GetPawnAttacks<Us>(from);
+    Bitboard captures = attacks & board.GetSide(!white) & allowed;
+    while (captures)
+        AddPawnMove(moves, from, PopLsb(captures), MOVE_CAPTURE);
+
+    int enPassant = board.GetEnPassantSquare();
+    if (enPassant == NO_SQUARE || !(attacks & SquareBB(enPassant)))
+        return;
+
+    // En passant removes two pieces from one rank, which can expose the king
+    // along it; it is rare enough to verify by playing it out.
+    BoardMove move(from, enPassant, MOVE_EN_PASSANT);
+    if (Legal)
+    {
+        Board after = board.Apply(move);
+        if (IsSquareAttacked(after, after.GetKingSquare(white), !white))
+            return;
+    }
+    moves.Add(move);
+}
+
+// Castling needs the king's start, transit and destination squares free of attack.
+template<Side Us>
+void GenerateCastlingMoves(const Board& board, MoveList& moves, int king, Bitboard attacked)
+{
+    constexpr bool white = Us == SIDE_WHITE;
+    constexpr uint8_t kingside = white ? WHITE_KINGSIDE : BLACK_KINGSIDE;
+    constexpr uint8_t queenside = white ? WHITE_QUEENSIDE : BLACK_QUEENSIDE;
+    uint8_t rights = board.GetCastlingRights() & (kingside | queenside);
+    if (!rights || (attacked & SquareBB(king)))
+        return;
+
+    Bitboard occupied = board.GetOccupied();
+    Bitboard rooks = board.GetPieces(PieceType::ROOK, white);
+
+    if ((rights & kingside) && (rooks & SquareBB(king + 3))
+        && !(occupied & (SquareBB(king + 1) | SquareBB(king + 2)))
+        && !(attacked & (SquareBB(king + 1) | SquareBB(king + 2))))
+        moves.Add(BoardMove(king, king + 2, MOVE_KING_CASTLE));
+
+    if ((rights & queenside) && (rooks & SquareBB(king - 4))
+        && !(occupied & (SquareBB(king - 1) | SquareBB(king - 2) | SquareBB(king - 3)))
+        && !(attacked & (SquareBB(king - 1) | SquareBB(king - 2))))
+        moves.Add(BoardMove(king, king - 2, MOVE_QUEEN_CASTLE));
+}
+
+// One loop per piece type instead of a switch per piece; a pinned piece may
+// only move along the line through its king.
+template<PieceType Type>
+void GeneratePieceMoves(MoveList& moves, Bitboard pieces, Bitboard occupied, Bitboard targets, Bitboard enemies, Bitboard pinned, int king)
+{
+    while (pieces)
+    {
+        int from = PopLsb(pieces);
+        Bitboard allowed = targets;
+        if (pinned & SquareBB(from))
+            allowed &= GetLine(king, from);
+        AddMoves(moves, from, GetAttacks<Type>(from, occupied) & allowed, enemies);
+    }
+}
+
+template<Side Us, bool Legal, MoveGenType Gen = GEN_ALL>
+void GenerateMoves(const Board& board, MoveList& moves, Bitboard fromMask)
+{
+    constexpr bool white = Us == SIDE_WHITE;
+    int king = board.GetKingSquare(white);
+    if (Legal && king == NO_SQUARE)
+    {
+        GenerateMoves<Us, false, Gen>(board, moves, fromMask);
+        return;
+    }
+
+    Bitboard occupied = board.GetOccupied();
+    Bitboard own = board.GetSide(white);
+    Bitboard enemies = board.GetSide(!white);
+    Bitboard genTargets = Gen == GEN_NOISY ? enemies : (Gen == GEN_QUIET ? ~occupied : ~0ULL);
+    Bitboard checkers = Legal ? GetCheckers(board) : 0;
+    Bitboard pinned = Legal ? GetPinnedPieces(board, white) : 0;
+
+    // The king is lifted off the board so that it cannot hide behind itself
+    // when stepping back along a checking ray.
+    if (king != NO_SQUARE && (fromMask & SquareBB(king)))
+    {
+        Bitboard attacked = GetAttackedSquares(board, !white, Legal ? occupied ^ SquareBB(king) : occupied);
+        AddMoves(moves, king, GetKingAttacks(king) & ~own & genTargets & (Legal ? ~attacked : ~0ULL), enemies);
+        if (!checkers && Gen != GEN_NOISY)
+            GenerateCastlingMoves<Us>(board, moves, king, attacked);
+    }
+
+    if (checkers & (checkers - 1))
+        return;
+
+    Bitboard targets = checkers ? checkers | GetBetween(king, Lsb(checkers)) : ~0ULL;
+    Bitboard movable = own & fromMask;
+
+    Bitboard pawns = board.GetPieces(PieceType::PAWN, white) & movable;
+    while (pawns)
+    {
+        int from = PopLsb(pawns);
+        Bitboard allowed = targets;
+        if (pinned & SquareBB(from))
+            allowed &= GetLine(king, from);
+        GeneratePawnMoves<Us, Legal, Gen>(board, moves, from, allowed);
+    }
+
+    targets &= ~own & genTargets;
+    GeneratePieceMoves<PieceType::KNIGHT>(moves, board.GetPieces(PieceType::KNIGHT, white) & movable, occupied, targets, enemies, pinned, king);
+    GeneratePieceMoves<PieceType::BISHOP>(moves, board.GetPieces(PieceType::BISHOP, white) & movable, occupied, targets, enemies, pinned, king);
+    GeneratePieceMoves<PieceType::ROOK>(moves, board.GetPieces(PieceType::ROOK, white) & movable, occupied, targets, enemies, pinned, king);
+    GeneratePieceMoves<PieceType::QUEEN>(moves, board.GetPieces(PieceType::QUEEN, white) & movable, occupied, targets, enemies, pinned, king);
+}
+
+}
+
+bool IsSquareAttacked(const Board& board, int square, bool byWhite)
+{
+    Bitboard occupied = board.GetOccupied();
+    Bitboard queens = board.GetPieces(PieceType::QUEEN, byWhite);
+
+    return (GetPawnAttacks(square, !byWhite) & board.GetPieces(PieceType::PAWN, byWhite))
+        || (GetKnightAttacks(square) & board.GetPieces(PieceType::KNIGHT, byWhite))
+        || (GetKingAttacks(square) & board.GetPieces(PieceType::KING, byWhite))
+        || (GetBishopAttacks(square, occupied) & (board.GetPieces(PieceType::BISHOP, byWhite) | queens))
+        || (GetRookAttacks(square, occupied) & (board.GetPieces(PieceType::ROOK, byWhite) | queens));
+}
+
+bool IsInCheck(const Board& board)
+{
+    bool white = board.IsWhiteToMove();
+    int king = board.GetKingSquare(white);
+    return king != NO_SQUARE && IsSquareAttacked(board, king, !white);
+}
+
+Bitboard GetAttackedSquares(const Board& board, bool byWhite, Bitboard occupied)
+{
+    Bitboard attacked = 0;
+
+    Bitboard pawns = board.GetPieces(PieceType::PAWN, byWhite);
+    while (pawns)
+        attacked |= GetPawnAttacks(PopLsb(pawns), byWhite);
+
+    Bitboard knights = board.GetPieces(PieceType::KNIGHT, byWhite);
+    while (knights)
+        attacked |= GetKnightAttacks(PopLsb(knights));
+
+    Bitboard queens = board.GetPieces(PieceType::QUEEN, byWhite);
+    Bitboard diagonal = board.GetPieces(PieceType::BISHOP, byWhite) | queens;
+    while (diagonal)
+        attacked |= GetBishopAttacks(PopLsb(diagonal), occupied);
+
+    Bitboard straight = board.GetPieces(PieceType::ROOK, byWhite) | queens;
+    while (straight)
+        attacked |= GetRookAttacks(PopLsb(straight), occupied);
+
+    int king = board.GetKingSquare(byWhite);
+    if (king != NO_SQUARE)
+        attacked |= GetKingAttacks(king);
+
+    return attacked;
+}
+
+Bitboard GetCheckers(const Board& board)
+{
+    bool white = board.IsWhiteToMove();
+    int king = board.GetKingSquare(white);
+    if (king == NO_SQUARE)
+        return 0;
+
+    Bitboard occupied = board.GetOccupied();
+    Bitboard queens = board.GetPieces(PieceType::QUEEN, !white);
+
+    return (GetPawnAttacks(king, white) & board.GetPieces(PieceType::PAWN, !white))
+        | (GetKnightAttacks(king) & board.GetPieces(PieceType::KNIGHT, !white))
+        | (GetBishopAttacks(king, occupied) & (board.GetPieces(PieceType::BISHOP, !white) | queens))
+        | (GetRookAttacks(king, occupied) & (board.GetPieces(PieceType::ROOK, !white) | queens));
+}
+
+Bitboard GetPinnedPieces(const Board& board, bool isWhite)
+{
+    int king = board.GetKingSquare(isWhite);
+    if (king == NO_SQUARE)
+        return 0;
+
+    Bitboard queens = board.GetPieces(PieceType::QUEEN, !isWhite);
+    Bitboard snipers = (GetRookAttacks(king, 0) & (board.GetPieces(PieceType::ROOK, !isWhite) | queens))
+        | (GetBishopAttacks(king, 0) & (board.GetPieces(PieceType::BISHOP, !isWhite) | queens));
+    Bitboard occupied = board.GetOccupied();
+    Bitboard pinned = 0;
+
+    while (snipers)
+    {
+        Bitboard blockers = GetBetween(king, PopLsb(snipers)) & occupied;
+        if (blockers && !(blockers & (blockers - 1)))
+            pinned |= blockers & board.GetSide(isWhite);
+    }
+    return pinned;
+}
+
+void GeneratePseudoLegalMoves(const Board& board, MoveList& moves, Bitboard fromMask)
+{
+    if (board.IsWhiteToMove())
+        GenerateMoves<SIDE_WHITE, false>(board, moves, fromMask);
+    else
+        GenerateMoves<SIDE_BLACK, false>(board, moves, fromMask);
+}
+
+void GenerateLegalMoves(const Board& board, MoveList& moves, Bitboard fromMask)
+{
+    if (board.IsWhiteToMove())
+        GenerateMoves<SIDE_WHITE, true>(board, moves, fromMask);
+    else
+        GenerateMoves<SIDE_BLACK, true>(board, moves, fromMask);
+}
+
+void GenerateNoisyMoves(const Board& board, MoveList& moves)
+{
+    if (board.IsWhiteToMove())
+        GenerateMoves<SIDE_WHITE, true, GEN_NOISY>(board, moves, ~0ULL);
+    else
+        GenerateMoves<SIDE_BLACK, true, GEN_NOISY>(board, moves, ~0ULL);
+}
+
+void GenerateQuietMoves(const Board& board, MoveList& moves)
+{
+    if (board.IsWhiteToMove())
+        GenerateMoves<SIDE_WHITE, true, GEN_QUIET>(board, moves, ~0ULL);
+    else
+        GenerateMoves<SIDE_BLACK, true, GEN_QUIET>(board, moves, ~0ULL);
+}
+
+bool IsLegalMove(const Board& board, const BoardMove& move)
+{
+    if (move.IsNull() || board.IsEmpty(move.GetFrom()) || board.IsWhiteAt(move.GetFrom()) != board.IsWhiteToMove())
+        return false;
+
+    MoveList moves;
+    GenerateLegalMoves(board, moves, SquareBB(move.GetFrom()));
+    for (const BoardMove& legal : moves)
+    {
+        if (legal == move)
+            return true;
+    }
+    return false;
+}
+
+MoveList GetLegalMovesFrom(const Board& board, int square)
+{
+    MoveList moves;
+    GenerateLegalMoves(board, moves, SquareBB(square));
+    return moves;
+}
+
+GameResult GetGameResult(const Board& board)
+{
+    MoveList moves;
+    GenerateLegalMoves(board, moves);
+    if (moves.IsEmpty())
+        return IsInCheck(board) ? GameResult::CHECKMATE : GameResult::STALEMATE;
+    return IsFiftyMoveDraw(board) ? GameResult::DRAW_FIFTY_MOVES : GameResult::ONGOING;
+}
@@ -0,0 +1,38 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include "Board.h"
+
+enum class GameResult {
+    ONGOING,
+    CHECKMATE,
+    STALEMATE,
+    DRAW_REPETITION,
+    DRAW_FIFTY_MOVES
+};
+
+// Which moves a generator produces. Noisy moves are captures, en passant
+// and promotions; quiet moves are everything else.
+enum MoveGenType {
+    GEN_ALL,
+    GEN_NOISY,
+    GEN_QUIET
+};
+
+bool IsSquareAttacked(const Board& board, int square, bool byWhite);
+bool IsInCheck(const Board& board);
+inline bool IsFiftyMoveDraw(const Board& board) { return board.GetHalfmoveClock() >= 100; }
+Bitboard GetAttackedSquares(const Board& board, bool byWhite, Bitboard occupied);
+Bitboard GetCheckers(const Board& board);
+Bitboard GetPinnedPieces(const Board& board, bool isWhite);
+
+void GeneratePseudoLegalMoves(const Board& board, MoveList& moves, Bitboard fromMask = ~0ULL);
+void GenerateLegalMoves(const Board& board, MoveList& moves, Bitboard fromMask = ~0ULL);
+void GenerateNoisyMoves(const Board& board, MoveList& moves);
+void GenerateQuietMoves(const Board& board, MoveList& moves);
+MoveList GetLegalMovesFrom(const Board& board, int square);
+bool IsLegalMove(const Board& board, const BoardMove& move);
+
+GameResult GetGameResult(const Board& board);
+
+#endif
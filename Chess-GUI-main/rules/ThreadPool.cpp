@@ -0,0 +1,71 @@
+#include "ThreadPool.h"
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(int threads) : threadCount(threads > 0 ? threads : 1)
+{
+    for (int i = 0; i < threadCount; i++)
+        queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+}
+
+uint64_t WorkStealingPool::GetSteals() const
+{
+    uint64_t steals = 0;
+    for (const auto& queue : queues)
+        steals += queue->steals;
+    return steals;
+}
+
+bool WorkStealingPool::PopLocal(int worker, int& task)
+{
+    WorkQueue& queue = *queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::Steal(int worker, int& task)
+{
+    for (int offset = 1; offset < threadCount; offset++)
+    {
+        WorkQueue& victim = *queues[(worker + offset) % threadCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            queues[worker]->steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+// No tasks are added while the batch runs, so a worker that finds every
+// deque empty is done.
+void WorkStealingPool::WorkerLoop(int worker, const std::function<void(int, int)>& body)
+{
+    int task;
+    while (PopLocal(worker, task) || Steal(worker, task))
+        body(task, worker);
+}
+
+void WorkStealingPool::Run(int taskCount, const std::function<void(int, int)>& body)
+{
+    for (auto& queue : queues)
+    {
+        queue->tasks.clear();
+        queue->steals = 0;
+    }
+    for (int task = 0; task < taskCount; task++)
+        queues[task % threadCount]->tasks.push_back(task);
+
+    std::vector<std::thread> threads;
+    for (int worker = 1; worker < threadCount; worker++)
+        threads.emplace_back(&WorkStealingPool::WorkerLoop, this, worker, std::cref(body));
+    WorkerLoop(0, body);
+    for (std::thread& thread : threads)
+        thread.join();
+}
@@ -0,0 +1,41 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Runs a batch of independent tasks on a fixed number of threads. Tasks are
+// dealt round-robin into one deque per worker; a worker takes from the back
+// of its own deque and, once that is empty, steals from the front of the
+// others, so uneven subtrees still keep every thread busy.
+class WorkStealingPool {
+private:
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;
+        std::deque<int> tasks;
+        uint64_t steals = 0;
+    };
+
+    int threadCount;
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+
+    bool PopLocal(int worker, int& task);
+    bool Steal(int worker, int& task);
+    void WorkerLoop(int worker, const std::function<void(int, int)>& body);
+
+public:
+    explicit WorkStealingPool(int threads);
+
+    int GetThreadCount() const { return threadCount; }
+    uint64_t GetSteals() const;
+
+    // Calls body(task, worker) once for every task in [0, taskCount) and
+    // returns when all of them are done; worker is below GetThreadCount().
+    void Run(int taskCount, const std::function<void(int, int)>& body);
+};
+
+#endif
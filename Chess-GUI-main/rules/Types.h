@@ -0,0 +1,66 @@
+#ifndef TYPES_H
+#define TYPES_H
+
+#include <cstdint>
+#include <string>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+typedef uint64_t Bitboard;
+
+enum class PieceType {
+    PAWN,
+    ROOK,
+    KNIGHT,
+    BISHOP,
+    QUEEN,
+    KING
+};
+
+// Named Side rather than Color, which raylib already defines; the GUI
+// includes both.
+enum Side : int {
+    SIDE_WHITE = 0,
+    SIDE_BLACK = 1
+};
+
+constexpr Side Opposite(Side side) { return side == SIDE_WHITE ? SIDE_BLACK : SIDE_WHITE; }
+
+const int NUM_PIECE_TYPES = 6;
+const int NUM_SQUARES = 64;
+const int NO_PIECE = -1;
+const int NO_SQUARE = -1;
+
+// Squares follow the GUI layout: index = y * 8 + x, so a8 is 0 and h1 is 63.
+constexpr int SquareOf(int x, int y) { return y * 8 + x; }
+constexpr int SquareX(int square) { return square & 7; }
+constexpr int SquareY(int square) { return square >> 3; }
+constexpr Bitboard SquareBB(int square) { return 1ULL << square; }
+std::string SquareName(int square);
+
+inline int Lsb(Bitboard b) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, b);
+    return (int)index;
+#else
+    return __builtin_ctzll(b);
+#endif
+}
+
+inline int PopLsb(Bitboard& b) {
+    int square = Lsb(b);
+    b &= b - 1;
+    return square;
+}
+
+inline int PopCount(Bitboard b) {
+#ifdef _MSC_VER
+    return (int)__popcnt64(b);
+#else
+    return __builtin_popcountll(b);
+#endif
+}
+
+#endif
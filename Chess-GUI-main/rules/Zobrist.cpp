@@ -0,0 +1,48 @@
+#include "Zobrist.h"
+
+uint64_t zobristPieces[2 * NUM_PIECE_TYPES][NUM_SQUARES];
+uint64_t zobristCastling[16];
+uint64_t zobristEnPassant[8];
+uint64_t zobristSide;
+
+namespace {
+
+struct ZobristInit {
+    ZobristInit() { InitZobrist(); }
+} zobristInit;
+
+// splitmix64 with a fixed seed, so keys are stable between runs and builds.
+uint64_t NextKey(uint64_t& state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+}
+
+void InitZobrist()
+{
+    uint64_t state = 0x5EED2024C0FFEEULL;
+
+    for (auto& piece : zobristPieces)
+        for (uint64_t& key : piece)
+            key = NextKey(state);
+
+    // One key per right, combined so that the table can be indexed by the mask.
+    uint64_t rightKeys[4];
+    for (uint64_t& key : rightKeys)
+        key = NextKey(state);
+    for (int rights = 0; rights < 16; rights++)
+    {
+        zobristCastling[rights] = 0;
+        for (int i = 0; i < 4; i++)
+            if (rights & (1 << i))
+                zobristCastling[rights] ^= rightKeys[i];
+    }
+
+    for (uint64_t& key : zobristEnPassant)
+        key = NextKey(state);
+    zobristSide = NextKey(state);
+}
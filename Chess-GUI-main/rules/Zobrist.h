@@ -0,0 +1,18 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "Types.h"
+
+extern uint64_t zobristPieces[2 * NUM_PIECE_TYPES][NUM_SQUARES];
+extern uint64_t zobristCastling[16];
+extern uint64_t zobristEnPassant[8];
+extern uint64_t zobristSide;
+
+void InitZobrist();
+
+inline uint64_t GetPieceKey(int piece, int square) { return zobristPieces[piece][square]; }
+inline uint64_t GetCastlingKey(int rights) { return zobristCastling[rights]; }
+inline uint64_t GetEnPassantKey(int square) { return zobristEnPassant[SquareX(square)]; }
+inline uint64_t GetSideKey() { return zobristSide; }
+
+#endif
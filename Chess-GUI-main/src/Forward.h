@@ -3,6 +3,7 @@
 
 
 class Game;
+class Board;
 class Team;
 class Piece;
 class Pawn;
@@ -2,7 +2,9 @@
 #include "Piece.h"
 #include "Team.h"
 #include "TextureManager.h"
+#include "Evaluate.h"
 #include <cmath>  
+#include <cstdio>
 #include <iostream>
 #include <cstring>  
 #include "raylib.h"
@@ -15,6 +17,7 @@ const Color Game::MOVE_HIGHLIGHT = GREEN;
 
 Sound moveSound;
 Sound captureSound;
+Sound castleSound;
 Sound checkSound;
 Sound promotionSound;
 Sound gameStartSound;
@@ -42,15 +45,25 @@ Move lastMove;
 Vector2 promotionSquare = {-1, -1};
 
 Game::Game() : 
-    whiteTeam(true),
-    blackTeam(false),
-    selectedPiece(nullptr),
-    isWhiteTurn(true),
+    showThreats(false),
+    showHanging(false),
+    engineSliceUs(0),
+    vsComputer(false),
+    whiteTeam(board, true),
+    blackTeam(board, false),
+    selectedSquare({-1, -1}),
     boardRotated(false),
     namesRotated(false),  
+    lastMove({{-1, -1}, {-1, -1}, PieceHandle()}),
     currentState(MENU),  
     promotionSquare({-1, -1})
 {
+    engineLimits.moveTimeMs = 1000;
+    board.Reset();
+    arena.Reset(board);
+    attacks.Compute(board);
+    status.Update(board);
+
     
     SetConfigFlags(FLAG_WINDOW_MAXIMIZED);
 
@@ -70,6 +83,9 @@ Game::Game() :
     captureSound = LoadSound("assets/capture.mp3");
 
     
+    castleSound = LoadSound("assets/castle.mp3");
+
+    
     checkSound = LoadSound("assets/check.mp3");
 
     
@@ -122,6 +138,9 @@ Game::~Game() {
     UnloadSound(captureSound);
 
     
+    UnloadSound(castleSound);
+
+    
     UnloadSound(checkSound);
 
     
@@ -165,6 +184,11 @@ void Game::Run() {
     while (!WindowShouldClose() && !shouldClose) {
         HandleInput();
 
+        // A time-sliced engine only thinks here, for a fixed share of each frame.
+        if (engineSliceUs > 0) {
+            slicedSearch.Step(engineSliceUs);
+        }
+
         
         if (currentRotation != targetRotation) {
             if (currentRotation < targetRotation) {
@@ -226,33 +250,27 @@ void Game::Draw() {
     
     if (GetGameState() == PLAY) {
         
-        if (selectedPiece) {
+        if (!selectedPiece.IsNull()) {
             for (const auto& move : validMoves) {
-                int drawX = boardRotated ? BOARD_SIZE - 1 - move.x : move.x;
-                int drawY = boardRotated ? BOARD_SIZE - 1 - move.y : move.y;
-                if (GetPieceAt(move.x, move.y) && GetPieceAt(move.x, move.y)->GetType() != PieceType::KING) {
+                int drawX = boardRotated ? BOARD_SIZE - 1 - SquareX(move.GetTo()) : SquareX(move.GetTo());
+                int drawY = boardRotated ? BOARD_SIZE - 1 - SquareY(move.GetTo()) : SquareY(move.GetTo());
+                if (move.IsEnPassant()) {
                     
                     DrawRectangle(
                         offsetX + drawX * TILE_SIZE,
                         offsetY + drawY * TILE_SIZE,
                         TILE_SIZE,
                         TILE_SIZE,
-                        RED
+                        BLUE
                     );
-                } else if (selectedPiece->GetType() == PieceType::PAWN &&
-                           abs(lastMove.end.y - lastMove.start.y) == 2 &&
-                           lastMove.piece->GetType() == PieceType::PAWN &&
-                           lastMove.end.x == move.x &&
-                           lastMove.end.y == selectedPiece->GetY() &&  
-                           abs(move.x - selectedPiece->GetX()) == 1 && 
-                           move.y == lastMove.end.y + (selectedPiece->IsWhite() ? -1 : 1)) { 
+                } else if (move.IsCapture()) {
                     
                     DrawRectangle(
                         offsetX + drawX * TILE_SIZE,
                         offsetY + drawY * TILE_SIZE,
                         TILE_SIZE,
                         TILE_SIZE,
-                        BLUE
+                        RED
                     );
                 }
             }
@@ -260,36 +278,18 @@ void Game::Draw() {
     }
 
     
-    const Piece* whiteKing = nullptr;
-    const Piece* blackKing = nullptr;
-    for (const auto& piece : whiteTeam.GetPieces()) {
-        if (piece->GetType() == PieceType::KING) {
-            whiteKing = piece.get();
-            break;
-        }
+    if (showThreats && GetGameState() == PLAY) {
+        DrawThreats(offsetX, offsetY);
     }
-    for (const auto& piece : blackTeam.GetPieces()) {
-        if (piece->GetType() == PieceType::KING) {
-            blackKing = piece.get();
-            break;
-        }
+    if (showHanging && GetGameState() == PLAY) {
+        DrawHangingPieces(offsetX, offsetY);
     }
 
     
-    if (whiteKing && IsSquareUnderAttack(whiteKing->GetX(), whiteKing->GetY(), false)) {
-        int drawX = boardRotated ? BOARD_SIZE - 1 - whiteKing->GetX() : whiteKing->GetX();
-        int drawY = boardRotated ? BOARD_SIZE - 1 - whiteKing->GetY() : whiteKing->GetY();
-        DrawRectangle(
-            offsetX + drawX * TILE_SIZE,
-            offsetY + drawY * TILE_SIZE,
-            TILE_SIZE,
-            TILE_SIZE,
-            Color{255, 0, 0, 100} 
-        );
-    }
-    if (blackKing && IsSquareUnderAttack(blackKing->GetX(), blackKing->GetY(), true)) {
-        int drawX = boardRotated ? BOARD_SIZE - 1 - blackKing->GetX() : blackKing->GetX();
-        int drawY = boardRotated ? BOARD_SIZE - 1 - blackKing->GetY() : blackKing->GetY();
+    int checkedKing = status.GetCheckedKing();
+    if (checkedKing != NO_SQUARE) {
+        int drawX = boardRotated ? BOARD_SIZE - 1 - SquareX(checkedKing) : SquareX(checkedKing);
+        int drawY = boardRotated ? BOARD_SIZE - 1 - SquareY(checkedKing) : SquareY(checkedKing);
         DrawRectangle(
             offsetX + drawX * TILE_SIZE,
             offsetY + drawY * TILE_SIZE,
@@ -300,41 +300,14 @@ void Game::Draw() {
     }
 
     
-    for (const auto& piece : whiteTeam.GetPieces()) {
-        Vector2 pos = GetCenteredPiecePosition(*piece);
-        Texture2D tex = piece->GetTexture();
-        if (tex.id > 0) {  
-            DrawTexture(tex, pos.x, pos.y, WHITE);
-        } else {
-            
-            DrawRectangle(pos.x, pos.y, TILE_SIZE/2, TILE_SIZE/2, WHITE);
-        }
-    }
-    
-    for (const auto& piece : blackTeam.GetPieces()) {
-        Vector2 pos = GetCenteredPiecePosition(*piece);
-        Texture2D tex = piece->GetTexture();
-        if (tex.id > 0) {  
-            DrawTexture(tex, pos.x, pos.y, WHITE);
-        } else {
-            
-            DrawRectangle(pos.x, pos.y, TILE_SIZE/2, TILE_SIZE/2, BLACK);
-        }
-    }
+    DrawPieces();
 
     
-    if (GetGameState() == PLAY && selectedPiece) {
+    if (GetGameState() == PLAY && !selectedPiece.IsNull()) {
         for (const auto& move : validMoves) {
-            int drawX = boardRotated ? BOARD_SIZE - 1 - move.x : move.x;
-            int drawY = boardRotated ? BOARD_SIZE - 1 - move.y : move.y;
-            if (!GetPieceAt(move.x, move.y) && 
-                !(selectedPiece->GetType() == PieceType::PAWN &&
-                  abs(lastMove.end.y - lastMove.start.y) == 2 &&
-                  lastMove.piece->GetType() == PieceType::PAWN &&
-                  lastMove.end.x == move.x &&
-                  lastMove.end.y == selectedPiece->GetY() &&
-                  abs(move.x - selectedPiece->GetX()) == 1 &&
-                  move.y == lastMove.end.y + (selectedPiece->IsWhite() ? -1 : 1))) {
+            int drawX = boardRotated ? BOARD_SIZE - 1 - SquareX(move.GetTo()) : SquareX(move.GetTo());
+            int drawY = boardRotated ? BOARD_SIZE - 1 - SquareY(move.GetTo()) : SquareY(move.GetTo());
+            if (!move.IsCapture()) {
                 
                 DrawCircle(
                     offsetX + (drawX * TILE_SIZE) + TILE_SIZE/2,
@@ -377,10 +350,25 @@ void Game::HandleInput() {
 
         if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
             
-            if (CheckCollisionPointRec(mousePos, whiteInputRect)) {
+            Rectangle computerToggleRect = {
+                (float)(inputX + inputWidth + 20),
+                (float)(inputY + 140),
+                200.0f,
+                (float)inputHeight
+            };
+
+            if (CheckCollisionPointRec(mousePos, computerToggleRect)) {
+                vsComputer = !vsComputer;
+                memset(blackPlayerName, 0, sizeof(blackPlayerName));
+                if (vsComputer) {
+                    strcpy(blackPlayerName, "Computer");
+                }
+                whiteNameActive = false;
+                blackNameActive = false;
+            } else if (CheckCollisionPointRec(mousePos, whiteInputRect)) {
                 whiteNameActive = true;
                 blackNameActive = false;
-            } else if (CheckCollisionPointRec(mousePos, blackInputRect)) {
+            } else if (CheckCollisionPointRec(mousePos, blackInputRect) && !vsComputer) {
                 whiteNameActive = false;
                 blackNameActive = true;
             } else {
@@ -522,15 +510,20 @@ void Game::HandleInput() {
                 shouldClose = true;
             } else if (CheckCollisionPointRec(mousePos, playAgainButton)) {
                 
-                isWhiteTurn = true;
                 boardRotated = false;
                 namesRotated = false;
-                selectedPiece = nullptr;
+                selectedPiece = PieceHandle();
                 validMoves.clear();
                 
                 
-                whiteTeam.Reset();
-                blackTeam.Reset();
+                engine.NewGame();
+                slicedSearch.NewGame();
+                vsComputer = false;
+                board.Reset();
+                arena.Reset(board);
+                attacks.Compute(board);
+                history.Clear();
+                status.Update(board);
                 
                 
                 whiteCapturedPieces.clear();
@@ -550,6 +543,18 @@ void Game::HandleInput() {
     }
 
     if (GetGameState() == PLAY) {
+        UpdateComputerPlayer();
+        if (GetGameState() != PLAY) {
+            return;
+        }
+
+        if (IsKeyPressed(KEY_T)) {
+            showThreats = !showThreats;
+        }
+        if (IsKeyPressed(KEY_H)) {
+            showHanging = !showHanging;
+        }
+
         if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
             Vector2 mousePos = GetMousePosition();
             Vector2 boardPos = ScreenToBoard(mousePos);
@@ -577,27 +582,34 @@ void Game::HandleInput() {
                 if (gameOverSound.stream.buffer != NULL) {
                     PlaySound(gameOverSound);
                 }
+                engine.Stop();
+                slicedSearch.Stop();
                 SetGameState(GAME_OVER);
                 return;
             }
+
+            if (IsComputerTurn()) {
+                return;
+            }
             
             if (boardPos.x >= 0 && boardPos.x < BOARD_SIZE &&
                 boardPos.y >= 0 && boardPos.y < BOARD_SIZE) {
                 
                 
-                Piece* clickedPiece = const_cast<Piece*>(GetPieceAt(boardPos.x, boardPos.y));
+                const Piece* clickedPiece = GetPieceAt(boardPos.x, boardPos.y);
                 
-                if (selectedPiece) {
+                if (!selectedPiece.IsNull()) {
                     
-                    if (clickedPiece && clickedPiece->IsWhite() == isWhiteTurn) {
+                    if (clickedPiece && clickedPiece->IsWhite() == board.IsWhiteToMove()) {
                         
-                        selectedPiece = clickedPiece;
-                        validMoves = GetValidMoves(selectedPiece);
+                        selectedPiece = arena.GetAt(SquareOf(boardPos.x, boardPos.y));
+                        selectedSquare = boardPos;
+                        validMoves = GetValidMoves(boardPos.x, boardPos.y);
                     } else {
                         
                         bool isValidMove = false;
                         for (const auto& move : validMoves) {
-                            if (move.x == boardPos.x && move.y == boardPos.y) {
+                            if (move.GetTo() == SquareOf(boardPos.x, boardPos.y)) {
                                 isValidMove = true;
                                 break;
                             }
@@ -605,33 +617,17 @@ void Game::HandleInput() {
                         
                         if (isValidMove) {
                             MovePiece(boardPos.x, boardPos.y);
-                            
-                            
-                            if (IsCheckmate(isWhiteTurn)) {
-                                namesRotated = !namesRotated;
-                                boardRotated = !boardRotated;
-                                if (checkmateSound.stream.buffer != NULL) {
-                                    PlaySound(checkmateSound);
-                                }
-                                SetGameState(GAME_OVER);
-                            } else if (IsStalemate(isWhiteTurn)) {
-                                namesRotated = !namesRotated;
-                                boardRotated = !boardRotated;
-                                if (stalemateSound.stream.buffer != NULL) {
-                                    PlaySound(stalemateSound);
-                                }
-                                SetGameState(GAME_OVER);
-                            }
                         } else {
                             
-                            selectedPiece = nullptr;
+                            selectedPiece = PieceHandle();
                             validMoves.clear();
                         }
                     }
-                } else if (clickedPiece && clickedPiece->IsWhite() == isWhiteTurn) {
+                } else if (clickedPiece && clickedPiece->IsWhite() == board.IsWhiteToMove()) {
                     
-                    selectedPiece = clickedPiece;
-                    validMoves = GetValidMoves(selectedPiece);
+                    selectedPiece = arena.GetAt(SquareOf(boardPos.x, boardPos.y));
+                    selectedSquare = boardPos;
+                    validMoves = GetValidMoves(boardPos.x, boardPos.y);
                 }
             }
         }
@@ -639,161 +635,134 @@ void Game::HandleInput() {
 }
 
 void Game::MovePiece(int x, int y) {
-    if (!selectedPiece) return;
+    if (selectedPiece.IsNull()) return;
 
     
-    Vector2 targetPos = {(float)x, (float)y};
-    bool isValidMove = false;
+    const BoardMove* chosenMove = nullptr;
     for (const auto& move : validMoves) {
-        if (move.x == targetPos.x && move.y == targetPos.y) {
-            isValidMove = true;
+        if (move.GetTo() == SquareOf(x, y)) {
+            chosenMove = &move;
             break;
         }
     }
 
-    if (isValidMove) {
-        
-        if (selectedPiece->GetType() == PieceType::PAWN &&
-            abs(lastMove.end.y - lastMove.start.y) == 2 &&
-            lastMove.piece->GetType() == PieceType::PAWN &&
-            lastMove.end.x == x &&
-            lastMove.end.y == selectedPiece->GetY() &&  
-            abs(x - selectedPiece->GetX()) == 1 &&      
-            y == lastMove.end.y + (selectedPiece->IsWhite() ? -1 : 1)) {  
-
-            
-            Piece* capturedPawn = const_cast<Piece*>(GetPieceAt(x, lastMove.end.y));
-            if (capturedPawn) {
-                AddCapturedPiece(capturedPawn->GetType(), capturedPawn->IsWhite());
-                if (capturedPawn->IsWhite()) {
-                    whiteTeam.RemovePieceAt(x, lastMove.end.y);
-                } else {
-                    blackTeam.RemovePieceAt(x, lastMove.end.y);
-                }
-            }
-
-            
-            if (captureSound.stream.buffer != NULL) {
-                PlaySound(captureSound);
-            }
-        }
-
-        
-        Piece* targetPiece = const_cast<Piece*>(GetPieceAt(x, y));
-        if (targetPiece && targetPiece->IsWhite() != selectedPiece->IsWhite()) {
-            if (targetPiece->GetType() == PieceType::KING) {
-                
-                return;
-            }
-            AddCapturedPiece(targetPiece->GetType(), targetPiece->IsWhite());
-            if (targetPiece->IsWhite()) {
-                whiteTeam.RemovePieceAt(x, y);
-            } else {
-                blackTeam.RemovePieceAt(x, y);
-            }
-            
-            if (captureSound.stream.buffer != NULL) {
-                PlaySound(captureSound);
-            }
-        }
-
-        
-        lastMove = {selectedPiece->GetPosition(), targetPos, selectedPiece};
-
-        selectedPiece->SetPosition(x, y);
-
-        
-        if (selectedPiece->GetType() == PieceType::PAWN) {
-            int promotionRank = selectedPiece->IsWhite() ? 0 : 7;
-            if (y == promotionRank) {
-                promotionSquare = {(float)x, (float)y};
-                SetGameState(PROMOTION);
-                
-                return;
-            }
-        }
-
-        
-        
-        if ((!targetPiece || targetPiece->IsWhite() == selectedPiece->IsWhite()) &&
-            moveSound.stream.buffer != NULL) {
-            PlaySound(moveSound);
-        }
-
-        
-        const Team& opposingTeam = isWhiteTurn ? blackTeam : whiteTeam;
-        const Piece* opposingKing = nullptr;
-        for (const auto& piece : opposingTeam.GetPieces()) {
-            if (piece->GetType() == PieceType::KING) {
-                opposingKing = piece.get();
-                break;
-            }
-        }
-        
-        if (opposingKing && IsSquareUnderAttack(opposingKing->GetX(), opposingKing->GetY(), isWhiteTurn)) {
-             if (IsCheckmate(!isWhiteTurn) || IsStalemate(!isWhiteTurn)) {
-
-             }
-            
-            else if (checkSound.stream.buffer != NULL) {
-                PlaySound(checkSound);
-            }
-        }
-
+    if (chosenMove) {
         
-        if (GetGameState() != PROMOTION) {
-            isWhiteTurn = !isWhiteTurn;
-            boardRotated = !boardRotated;
-            namesRotated = !namesRotated;
+        if (chosenMove->IsPromotion()) {
+            pendingPromotion = *chosenMove;
+            promotionSquare = {(float)x, (float)y};
+            SetGameState(PROMOTION);
+        } else {
+            PlayMove(*chosenMove);
         }
     }
 
     
-    selectedPiece = nullptr;
+    selectedPiece = PieceHandle();
     validMoves.clear();
 }
 
-void Game::PromotePawn(PieceType type) {
+void Game::PlayMove(const BoardMove& move) {
     
-    Team& team = isWhiteTurn ? whiteTeam : blackTeam;
-    team.RemovePieceAt(promotionSquare.x, promotionSquare.y);
-    team.AddPiece(type, promotionSquare.x, promotionSquare.y);
+    if (move.IsCapture()) {
+        PieceType capturedType = move.IsEnPassant() ? PieceType::PAWN : board.GetTypeAt(move.GetTo());
+        AddCapturedPiece(capturedType, !board.IsWhiteToMove());
 
-    
-    if (promotionSound.stream.buffer != NULL) {
-        PlaySound(promotionSound);
+        
+        if (captureSound.stream.buffer != NULL) {
+            PlaySound(captureSound);
         }
+    }
 
     
-    selectedPiece = nullptr;
-    validMoves.clear();
+    arena.ApplyMove(board, move);
+    lastMove = {
+        Vector2{(float)SquareX(move.GetFrom()), (float)SquareY(move.GetFrom())},
+        Vector2{(float)SquareX(move.GetTo()), (float)SquareY(move.GetTo())},
+        arena.GetAt(move.GetTo())
+    };
+
+    history.Push(board.GetKey());
+    Board after = board.Apply(move);
+    attacks.Update(board, after, move);
+    board = after;
+    status.Update(board, history);
 
     
-    isWhiteTurn = !isWhiteTurn;
-    boardRotated = !boardRotated;
-    namesRotated = !namesRotated;
-    
-    
+    if (move.IsPromotion()) {
+        if (promotionSound.stream.buffer != NULL) {
+            PlaySound(promotionSound);
+        }
+    } else if (move.IsCastle()) {
+        if (castleSound.stream.buffer != NULL) {
+            PlaySound(castleSound);
+        }
+    } else if (!move.IsCapture() && moveSound.stream.buffer != NULL) {
+        PlaySound(moveSound);
+    }
 
     
-    if (IsCheckmate(isWhiteTurn)) {
-        boardRotated = !boardRotated;
-        namesRotated = !namesRotated;
+    GameResult result = status.GetResult();
+    if (result == GameResult::CHECKMATE) {
         if (checkmateSound.stream.buffer != NULL) {
-                    PlaySound(checkmateSound);
+            PlaySound(checkmateSound);
         }
         SetGameState(GAME_OVER);
-    } else if (IsStalemate(isWhiteTurn)) {
-        boardRotated = !boardRotated;
-        namesRotated = !namesRotated;
+    } else if (status.IsDraw()) {
         if (stalemateSound.stream.buffer != NULL) {
-                    PlaySound(stalemateSound);
+            PlaySound(stalemateSound);
         }
         SetGameState(GAME_OVER);
     } else {
+        if (status.IsInCheck() && checkSound.stream.buffer != NULL) {
+            PlaySound(checkSound);
+        }
+        
+        if (!vsComputer) {
+            boardRotated = !boardRotated;
+            namesRotated = !namesRotated;
+        }
         SetGameState(PLAY);
     }
-        promotionSquare = {-1, -1};
+}
+
+// The engine is started once per computer turn and polled every frame; its
+// move goes through PlayMove like a click would. With a time slice set, the
+// sliced search is used instead and Run advances it.
+void Game::UpdateComputerPlayer() {
+    if (!IsComputerTurn()) {
+        return;
+    }
+
+    bool sliced = engineSliceUs > 0;
+    if (sliced ? slicedSearch.HasResult() : engine.HasResult()) {
+        SearchResult result = sliced ? slicedSearch.TakeResult() : engine.TakeResult();
+        if (!result.bestMove.IsNull()) {
+            selectedPiece = PieceHandle();
+            validMoves.clear();
+            PlayMove(result.bestMove);
+        }
+    } else if (sliced && !slicedSearch.IsThinking()) {
+        slicedSearch.Start(board, history, engineLimits);
+    } else if (!sliced && !engine.IsThinking()) {
+        engine.Start(board, history, engineLimits);
+    }
+}
+
+// Only the search that will be used gets the table, so a large hash is not
+// allocated twice. Set the time slice first.
+bool Game::SetEngineHashSize(int megabytes) {
+    if (engineSliceUs > 0) {
+        return slicedSearch.SetHashSize(megabytes > 0 ? megabytes : 1);
+    }
+    return engine.SetHashSize(megabytes > 0 ? megabytes : 1);
+}
+
+void Game::PromotePawn(PieceType type) {
+    
+    pendingPromotion = pendingPromotion.WithPromotion(type);
+    PlayMove(pendingPromotion);
+    promotionSquare = {-1, -1};
 }
 
 void Game::DrawPromotionUI() {
@@ -804,7 +773,7 @@ void Game::DrawPromotionUI() {
     auto texManager = TextureManager::GetInstance();
     
     
-    bool isWhitePiece = isWhiteTurn;
+    bool isWhitePiece = board.IsWhiteToMove();
 
     
     int boardPixelSize = TILE_SIZE * BOARD_SIZE;
@@ -898,7 +867,7 @@ void Game::DrawLabels() {
         };
 
         
-        if (this->isWhiteTurn) {
+        if (board.IsWhiteToMove()) {
             
             
             const char* blackHeader = "Black's Captures";
@@ -941,6 +910,27 @@ void Game::DrawLabels() {
             
             drawCapturedPieces(blackCapturedPieces, leftSectionX, capturedY, false);
         }
+
+        
+        // Evaluation bar between the left captured panel and the rank labels,
+        // white's share filling from white's edge of the board.
+        const int EVAL_BAR_WIDTH = 16;
+        const int EVAL_BAR_MARGIN = 12;
+        int whiteScore = board.IsWhiteToMove() ? Evaluate(board) : -Evaluate(board);
+        float whiteShare = 1.0f / (1.0f + powf(10.0f, -whiteScore / 400.0f));
+        int whiteHeight = (int)(boardPixelSize * whiteShare);
+        int barX = offsetX - LABEL_SIZE - LABEL_MARGIN * 3 - EVAL_BAR_MARGIN - EVAL_BAR_WIDTH;
+        int whiteY = boardRotated ? offsetY : offsetY + boardPixelSize - whiteHeight;
+        DrawRectangle(barX, offsetY, EVAL_BAR_WIDTH, boardPixelSize, BLACK);
+        DrawRectangle(barX, whiteY, EVAL_BAR_WIDTH, whiteHeight, RAYWHITE);
+        DrawRectangleLines(barX, offsetY, EVAL_BAR_WIDTH, boardPixelSize, GRAY);
+
+        char evalText[16];
+        snprintf(evalText, sizeof(evalText), "%+.1f", whiteScore / 100.0f);
+        int evalTextWidth = MeasureTextEx(gameFont, evalText, LABEL_SIZE, 0).x;
+        DrawTextEx(gameFont, evalText,
+            Vector2{(float)(barX + EVAL_BAR_WIDTH / 2 - evalTextWidth / 2), (float)(offsetY + boardPixelSize + LABEL_MARGIN)},
+            LABEL_SIZE, 0, LABEL_COLOR);
     }
 
     
@@ -1069,25 +1059,63 @@ void Game::DrawBoard() {
     }
 
     
-    for (const auto& piece : whiteTeam.GetPieces()) {
-        Vector2 pos = GetCenteredPiecePosition(*piece);
+    DrawPieces();
+}
+
+void Game::DrawPieces() {
+    for (int slot = 0; slot < PieceArena::CAPACITY; slot++) {
+        if (!arena.IsSlotAlive(slot)) continue;
+
+        int square = arena.GetSlotSquare(slot);
+        bool isWhite = arena.IsSlotWhite(slot);
+        const Piece* piece = (isWhite ? whiteTeam : blackTeam).GetPiece(arena.GetSlotType(slot));
+        Vector2 pos = GetCenteredPiecePosition(*piece, SquareX(square), SquareY(square));
         Texture2D tex = piece->GetTexture();
         if (tex.id > 0) {  
             DrawTexture(tex, pos.x, pos.y, WHITE);
         } else {
             
-            DrawRectangle(pos.x, pos.y, TILE_SIZE/2, TILE_SIZE/2, WHITE);
+            DrawRectangle(pos.x, pos.y, TILE_SIZE/2, TILE_SIZE/2, isWhite ? WHITE : BLACK);
         }
     }
-    
-    for (const auto& piece : blackTeam.GetPieces()) {
-        Vector2 pos = GetCenteredPiecePosition(*piece);
-        Texture2D tex = piece->GetTexture();
-        if (tex.id > 0) {  
-            DrawTexture(tex, pos.x, pos.y, WHITE);
-        } else {
-            
-            DrawRectangle(pos.x, pos.y, TILE_SIZE/2, TILE_SIZE/2, BLACK);
+}
+
+// Shades every square the side not to move attacks, darker for each
+// additional attacker. Toggled with T.
+void Game::DrawThreats(int offsetX, int offsetY) {
+    bool byWhite = !board.IsWhiteToMove();
+    Bitboard threatened = attacks.GetAttacked(byWhite);
+    while (threatened) {
+        int square = PopLsb(threatened);
+        int drawX = boardRotated ? BOARD_SIZE - 1 - SquareX(square) : SquareX(square);
+        int drawY = boardRotated ? BOARD_SIZE - 1 - SquareY(square) : SquareY(square);
+        int count = attacks.GetAttackerCount(square, byWhite);
+        DrawRectangle(
+            offsetX + drawX * TILE_SIZE,
+            offsetY + drawY * TILE_SIZE,
+            TILE_SIZE,
+            TILE_SIZE,
+            Color{255, 140, 0, (unsigned char)(count >= 3 ? 150 : 50 * count)}
+        );
+    }
+}
+
+// Rings every piece, of either side, that the opponent can win material
+// against by exchanging on its square. Toggled with H.
+void Game::DrawHangingPieces(int offsetX, int offsetY) {
+    Bitboard hanging = GetHangingPieces(board, true) | GetHangingPieces(board, false);
+    while (hanging) {
+        int square = PopLsb(hanging);
+        int drawX = boardRotated ? BOARD_SIZE - 1 - SquareX(square) : SquareX(square);
+        int drawY = boardRotated ? BOARD_SIZE - 1 - SquareY(square) : SquareY(square);
+        for (int inset = 0; inset < 3; inset++) {
+            DrawRectangleLines(
+                offsetX + drawX * TILE_SIZE + inset,
+                offsetY + drawY * TILE_SIZE + inset,
+                TILE_SIZE - 2 * inset,
+                TILE_SIZE - 2 * inset,
+                RED
+            );
         }
     }
 }
@@ -1137,6 +1165,12 @@ void Game::DrawMenu() {
     DrawTextEx(gameFont, blackPlayerName, Vector2{(float)(inputX + 15), (float)(inputY + 135 + 20 - 3)}, 25, 0, BLACK);  
 
     
+    const char* computerText = "vs Computer";
+    int computerWidth = MeasureTextEx(gameFont, computerText, 25, 0).x;
+    DrawRectangle(inputX + inputWidth + 20, inputY + 140, 200, inputHeight, vsComputer ? LIGHTGRAY : RAYWHITE);
+    DrawTextEx(gameFont, computerText, Vector2{(float)(inputX + inputWidth + 20 + (200 - computerWidth) / 2), (float)(inputY + 152)}, 25, 0, vsComputer ? DARKGREEN : BLACK);
+
+    
     int buttonWidth = playWidth + 100;  
     int buttonHeight = 60;  
     int buttonX = (GetScreenWidth() - buttonWidth) / 2;
@@ -1213,9 +1247,9 @@ Vector2 Game::BoardToScreen(int x, int y) {
     };
 }
 
-Vector2 Game::GetCenteredPiecePosition(const Piece& piece) {
+Vector2 Game::GetCenteredPiecePosition(const Piece& piece, int x, int y) {
     
-    Vector2 boardPos = BoardToScreen(piece.GetX(), piece.GetY());
+    Vector2 boardPos = BoardToScreen(x, y);
 
     
     return (Vector2){
@@ -1234,116 +1268,38 @@ const Team& Game::GetBlackTeam() const {
 
 void Game::SelectPiece(int x, int y) {
     
-    selectedPiece = nullptr;
+    selectedPiece = PieceHandle();
     validMoves.clear();
 
     
     const Piece* piece = GetPieceAt(x, y);
-    if (piece && piece->IsWhite() == isWhiteTurn) {
-        selectedPiece = const_cast<Piece*>(piece);
-        validMoves = GetValidMoves(selectedPiece);
+    if (piece && piece->IsWhite() == board.IsWhiteToMove()) {
+        selectedPiece = arena.GetAt(SquareOf(x, y));
+        selectedSquare = {(float)x, (float)y};
+        validMoves = GetValidMoves(x, y);
     }
 }
 
-bool Game::IsSquareUnderAttack(int x, int y, bool byWhite, Vector2 ignorePiecePos) const {
-    const Team& attackingTeam = byWhite ? whiteTeam : blackTeam;
-    
-    
-    for (const auto& piece : attackingTeam.GetPieces()) {
-        
-        if (piece->GetX() == ignorePiecePos.x && piece->GetY() == ignorePiecePos.y) {
-            continue;
-        }
-        
-        
-        auto moves = piece->GetValidMoves(*this);
-        
-        
-        for (const auto& move : moves) {
-            if (move.x == x && move.y == y) {
-                return true;
-            }
-        }
-    }
-    return false;
+bool Game::IsSquareUnderAttack(int x, int y, bool byWhite) const {
+    return attacks.IsAttacked(SquareOf(x, y), byWhite);
 }
 
- vector<Vector2> Game::GetValidMoves(Piece* piece) {
-    if (!piece) return {};
-
-     vector<Vector2> moves = piece->GetValidMoves(*this);
-     vector<Vector2> legalMoves;
-
-    
-    const Team& ourTeam = piece->IsWhite() ? whiteTeam : blackTeam;
-    const Piece* ourKing = nullptr;
-    for (const auto& p : ourTeam.GetPieces()) {
-        if (p->GetType() == PieceType::KING) {
-            ourKing = p.get();
-            break;
-        }
-    }
-
-    if (!ourKing) return moves; 
-
-    
-    Vector2 originalPos = piece->GetPosition();
-
-    
-    for (const auto& move : moves) {
-        
-        Piece* capturedPiece = const_cast<Piece*>(GetPieceAt(move.x, move.y));
-        bool wasCaptured = false;
-
-        
-        if (capturedPiece) {
-            wasCaptured = true;
-            capturedPiece->SetPosition(-1, -1); 
-        }
-
-        
-        piece->SetPosition(move.x, move.y);
-
-        
-        bool kingInCheck;
-        if (piece->GetType() == PieceType::KING) {
-            
-            kingInCheck = IsSquareUnderAttack(move.x, move.y, !piece->IsWhite(), Vector2{-1, -1});
-        } else {
-            kingInCheck = IsSquareUnderAttack(ourKing->GetX(), ourKing->GetY(), !piece->IsWhite(), originalPos);
-        }
-
-        
-        piece->SetPosition(originalPos.x, originalPos.y);
-        if (wasCaptured) {
-            capturedPiece->SetPosition(move.x, move.y); 
-        }
-
-        
-        if (!kingInCheck) {
-            legalMoves.push_back(move);
-        }
-    }
-
-    return legalMoves;
+vector<BoardMove> Game::GetValidMoves(int x, int y) const {
+    return status.GetMovesFrom(SquareOf(x, y));
 }
 
 const Piece* Game::GetPieceAt(int x, int y) const {
-    
-    for (const auto& piece : whiteTeam.GetPieces()) {
-        if (piece->GetX() == x && piece->GetY() == y) {
-            return piece.get();
-        }
+    if (x < 0 || x >= BOARD_SIZE || y < 0 || y >= BOARD_SIZE) {
+        return nullptr;
     }
-    
-    
-    for (const auto& piece : blackTeam.GetPieces()) {
-        if (piece->GetX() == x && piece->GetY() == y) {
-            return piece.get();
-        }
+
+    PieceHandle handle = arena.GetAt(SquareOf(x, y));
+    if (handle.IsNull()) {
+        return nullptr;
     }
-    
-    return nullptr;
+
+    const Team& team = arena.IsWhite(handle) ? whiteTeam : blackTeam;
+    return team.GetPiece(arena.GetType(handle));
 }
 
 void Game::ToggleBoardRotation() {
@@ -1352,64 +1308,16 @@ void Game::ToggleBoardRotation() {
 
 bool Game::IsCheckmate(bool isWhite) {
     
-    const Team& team = isWhite ? whiteTeam : blackTeam;
-    
-    
-    const Piece* king = nullptr;
-    for (const auto& piece : team.GetPieces()) {
-        if (piece->GetType() == PieceType::KING) {
-            king = piece.get();
-            break;
-        }
-    }
-    
-    if (!king) return false; 
-    
-    
-    if (!IsSquareUnderAttack(king->GetX(), king->GetY(), !isWhite)) {
-        return false;
-    }
-    
-    
-    for (const auto& piece : team.GetPieces()) {
-        auto moves = GetValidMoves(const_cast<Piece*>(piece.get()));
-        if (!moves.empty()) {
-            return false; 
-        }
-    }
-    
-    return true; 
+    if (board.IsWhiteToMove() != isWhite) return false;
+
+    return status.GetResult() == GameResult::CHECKMATE;
 }
 
 bool Game::IsStalemate(bool isWhite) {
     
-    const Team& team = isWhite ? whiteTeam : blackTeam;
-    
-    
-    const Piece* king = nullptr;
-    for (const auto& piece : team.GetPieces()) {
-        if (piece->GetType() == PieceType::KING) {
-            king = piece.get();
-            break;
-        }
-    }
-    
-    if (!king) return false; 
-    
-    
-    if (IsSquareUnderAttack(king->GetX(), king->GetY(), !isWhite)) {
-        return false;
-    }
-    
-    
-    for (const auto& piece : team.GetPieces()) {
-        auto moves = GetValidMoves(const_cast<Piece*>(piece.get()));
-        if (!moves.empty()) {
-            return false; 
-        }
-    }
-    
-    return true; 
+    if (board.IsWhiteToMove() != isWhite) return false;
+
+    return status.GetResult() == GameResult::STALEMATE;
 }
 
 void Game::DrawGameOverUI() {
@@ -1417,8 +1325,8 @@ void Game::DrawGameOverUI() {
     DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Color{0, 0, 0, 200});
 
     
-    bool isCheckmate = IsCheckmate(isWhiteTurn);
-    bool isStalemate = IsStalemate(isWhiteTurn);
+    bool isCheckmate = IsCheckmate(board.IsWhiteToMove());
+    bool isStalemate = status.IsDraw();
     bool isResignation = !isCheckmate && !isStalemate;  
 
     
@@ -1441,8 +1349,8 @@ void Game::DrawGameOverUI() {
 
     if (isCheckmate) {
         
-        const char* winnerName = isWhiteTurn ? blackPlayerName : whitePlayerName;
-        const char* loserName = isWhiteTurn ? whitePlayerName : blackPlayerName;
+        const char* winnerName = board.IsWhiteToMove() ? blackPlayerName : whitePlayerName;
+        const char* loserName = board.IsWhiteToMove() ? whitePlayerName : blackPlayerName;
 
         
         char winnerMsg[100];
@@ -1475,6 +1383,11 @@ void Game::DrawGameOverUI() {
 
         
         const char* byMsg = "(By Stalemate)";
+        if (status.GetResult() == GameResult::DRAW_REPETITION) {
+            byMsg = "(By Threefold Repetition)";
+        } else if (status.GetResult() == GameResult::DRAW_FIFTY_MOVES) {
+            byMsg = "(By Fifty-Move Rule)";
+        }
         int byWidth = MeasureTextEx(gameFont, byMsg, MESSAGE_SIZE, 0).x;
         DrawTextEx(gameFont, byMsg, Vector2{(float)(centerX - byWidth / 2), (float)(startY + LINE_SPACING * 4 - 27)}, MESSAGE_SIZE, 0, TEXT_COLOR);
 
@@ -1485,8 +1398,8 @@ void Game::DrawGameOverUI() {
         DrawTextEx(gameFont, playersMsg, Vector2{(float)(centerX - playersWidth / 2), (float)(startY + LINE_SPACING * 6)}, CONGRATS_SIZE, 0, TEXT_COLOR);
     } else if (isResignation) {
         
-        const char* winnerName = isWhiteTurn ? blackPlayerName : whitePlayerName;
-        const char* loserName = isWhiteTurn ? whitePlayerName : blackPlayerName;
+        const char* winnerName = board.IsWhiteToMove() ? blackPlayerName : whitePlayerName;
+        const char* loserName = board.IsWhiteToMove() ? whitePlayerName : blackPlayerName;
 
         
         char winnerMsg[100];
@@ -6,8 +6,17 @@
 #include <vector>
 
 
+#include "Board.h"
+#include "Rules.h"
+#include "PositionStatus.h"
+#include "History.h"
+#include "AttackMap.h"
+#include "Engine.h"
+#include "SlicedSearch.h"
+#include "See.h"
 #include "Team.h"
 #include "Piece.h"
+#include "PieceArena.h"
 
 enum GameState {
     MENU,
@@ -19,7 +28,7 @@ enum GameState {
 struct Move {
     Vector2 start;
     Vector2 end;
-    Piece* piece;
+    PieceHandle piece;
 };
 
 class Game {
@@ -30,11 +39,24 @@ private:
     static const Color DARK_SQUARE;
     static const Color MOVE_HIGHLIGHT;
 
+    Board board;
+    PositionStatus status;
+    PositionHistory history;
+    AttackMap attacks;
+    bool showThreats;
+    bool showHanging;
+    Engine engine;
+    SlicedSearch slicedSearch;
+    int64_t engineSliceUs;
+    SearchLimits engineLimits;
+    bool vsComputer;
     Team whiteTeam;
     Team blackTeam;
-    Piece* selectedPiece;
-    std::vector<Vector2> validMoves;
-    bool isWhiteTurn;
+    PieceArena arena;
+    PieceHandle selectedPiece;
+    Vector2 selectedSquare;
+    std::vector<BoardMove> validMoves;
+    BoardMove pendingPromotion;
     bool boardRotated;
     bool namesRotated;
     Move lastMove;
@@ -57,16 +79,22 @@ public:
 
     void Run();
     void DrawBoard();
+    void DrawPieces();
+    void DrawThreats(int offsetX, int offsetY);
+    void DrawHangingPieces(int offsetX, int offsetY);
     Vector2 ScreenToBoard(Vector2 screenPos);
     Vector2 BoardToScreen(int x, int y);
-    Vector2 GetCenteredPiecePosition(const Piece& piece);
+    Vector2 GetCenteredPiecePosition(const Piece& piece, int x, int y);
     void SelectPiece(int x, int y);
     void MovePiece(int x, int y);
-    std::vector<Vector2> GetValidMoves(Piece* piece);
+    std::vector<BoardMove> GetValidMoves(int x, int y) const;
     const Team& GetWhiteTeam() const;
     const Team& GetBlackTeam() const;
+    const Board& GetBoard() const { return board; }
+    const PieceArena& GetPieceArena() const { return arena; }
+    const AttackMap& GetAttackMap() const { return attacks; }
     const Piece* GetPieceAt(int x, int y) const;
-    bool IsSquareUnderAttack(int x, int y, bool byWhite, Vector2 ignorePiecePos = {-1, -1}) const;
+    bool IsSquareUnderAttack(int x, int y, bool byWhite) const;
     void ToggleBoardRotation();
     void DrawLabels();
     void DrawMenu();
@@ -75,6 +103,11 @@ public:
     void PromotePawn(PieceType type);
     GameState GetGameState() const { return currentState; }
     void SetGameState(GameState state) { currentState = state; }
+    void SetEngineLimits(const SearchLimits& limits) { engineLimits = limits; }
+    void SetEngineThreads(int threads) { engine.SetThreads(threads); }
+    bool SetEngineHashSize(int megabytes);
+    void SetEngineTimeSlice(int64_t microseconds) { engineSliceUs = microseconds; }
+    bool IsComputerTurn() const { return vsComputer && !board.IsWhiteToMove(); }
 
     
     void AddCapturedPiece(PieceType type, bool isWhite);
@@ -83,6 +116,8 @@ public:
 
 private:
     void HandleInput();
+    void PlayMove(const BoardMove& move);
+    void UpdateComputerPlayer();
     void Draw();
     bool IsCheckmate(bool isWhite);
     bool IsStalemate(bool isWhite);
@@ -0,0 +1,106 @@
+#include "PieceArena.h"
+#include <cstring>
+
+PieceArena::PieceArena() : freeCount(0)
+{
+    memset(generations, 0, sizeof(generations));
+    memset(alive, 0, sizeof(alive));
+    for (int slot = CAPACITY - 1; slot >= 0; slot--)
+        freeSlots[freeCount++] = (int8_t)slot;
+    memset(slotAt, -1, sizeof(slotAt));
+}
+
+PieceHandle PieceArena::Allocate(PieceType type, bool isWhite, int square)
+{
+    PieceHandle handle;
+    if (freeCount == 0)
+        return handle;
+
+    int slot = freeSlots[--freeCount];
+    types[slot] = type;
+    white[slot] = isWhite;
+    squares[slot] = (int8_t)square;
+    alive[slot] = true;
+    slotAt[square] = (int8_t)slot;
+
+    handle.index = (uint16_t)slot;
+    handle.generation = generations[slot];
+    return handle;
+}
+
+void PieceArena::Release(int slot)
+{
+    slotAt[squares[slot]] = -1;
+    alive[slot] = false;
+    generations[slot]++;
+    freeSlots[freeCount++] = (int8_t)slot;
+}
+
+void PieceArena::Relocate(int from, int to)
+{
+    int slot = slotAt[from];
+    if (slot < 0)
+        return;
+    slotAt[from] = -1;
+    slotAt[to] = (int8_t)slot;
+    squares[slot] = (int8_t)to;
+}
+
+void PieceArena::Reset(const Board& board)
+{
+    for (int slot = 0; slot < CAPACITY; slot++)
+    {
+        if (alive[slot])
+            Release(slot);
+    }
+
+    Bitboard occupied = board.GetOccupied();
+    while (occupied)
+    {
+        int square = PopLsb(occupied);
+        Allocate(board.GetTypeAt(square), board.IsWhiteAt(square), square);
+    }
+}
+
+// Mirrors Board::MakeMove; before is the position the move is played from.
+void PieceArena::ApplyMove(const Board& before, const BoardMove& move)
+{
+    int from = move.GetFrom();
+    int to = move.GetTo();
+    bool isWhite = before.IsWhiteToMove();
+
+    int captured = move.IsEnPassant() ? to + (isWhite ? 8 : -8) : to;
+    if (slotAt[captured] >= 0)
+        Release(slotAt[captured]);
+
+    Relocate(from, to);
+
+    if (move.IsCastle())
+    {
+        bool kingside = move.GetFlags() == MOVE_KING_CASTLE;
+        Relocate(kingside ? from + 3 : from - 4, kingside ? from + 1 : from - 1);
+    }
+
+    if (move.IsPromotion() && slotAt[to] >= 0)
+    {
+        Release(slotAt[to]);
+        Allocate(move.GetPromotion(), isWhite, to);
+    }
+}
+
+PieceHandle PieceArena::GetAt(int square) const
+{
+    PieceHandle handle;
+    int slot = slotAt[square];
+    if (slot >= 0)
+    {
+        handle.index = (uint16_t)slot;
+        handle.generation = generations[slot];
+    }
+    return handle;
+}
+
+bool PieceArena::IsValid(PieceHandle handle) const
+{
+    return handle.index < CAPACITY && alive[handle.index] && generations[handle.index] == handle.generation;
+}
@@ -0,0 +1,58 @@
+#ifndef PIECE_ARENA_H
+#define PIECE_ARENA_H
+
+#include "Board.h"
+#include <cstdint>
+
+// Names one piece for as long as it stays on the board. A captured or
+// promoted piece's slot is reused with a new generation, so old handles to
+// it stop resolving instead of pointing at whatever took its place.
+struct PieceHandle {
+    uint16_t index = 0xFFFF;
+    uint16_t generation = 0;
+
+    bool IsNull() const { return index == 0xFFFF; }
+    bool operator==(const PieceHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const PieceHandle& other) const { return !(*this == other); }
+};
+
+// The GUI's pieces in a fixed arena of 32 slots, stored as parallel arrays.
+// Reset, captures and promotions only move slots on and off the free list.
+class PieceArena {
+public:
+    static const int CAPACITY = 32;
+
+private:
+    PieceType types[CAPACITY];
+    bool white[CAPACITY];
+    int8_t squares[CAPACITY];
+    uint16_t generations[CAPACITY];
+    bool alive[CAPACITY];
+    int8_t freeSlots[CAPACITY];
+    int freeCount;
+    int8_t slotAt[NUM_SQUARES];
+
+    PieceHandle Allocate(PieceType type, bool isWhite, int square);
+    void Release(int slot);
+    void Relocate(int from, int to);
+
+public:
+    PieceArena();
+
+    void Reset(const Board& board);
+    void ApplyMove(const Board& before, const BoardMove& move);
+
+    PieceHandle GetAt(int square) const;
+    bool IsValid(PieceHandle handle) const;
+    PieceType GetType(PieceHandle handle) const { return types[handle.index]; }
+    bool IsWhite(PieceHandle handle) const { return white[handle.index]; }
+    int GetSquare(PieceHandle handle) const { return squares[handle.index]; }
+
+    // Raw slot access for loops over every piece.
+    bool IsSlotAlive(int slot) const { return alive[slot]; }
+    PieceType GetSlotType(int slot) const { return types[slot]; }
+    bool IsSlotWhite(int slot) const { return white[slot]; }
+    int GetSlotSquare(int slot) const { return squares[slot]; }
+};
+
+#endif
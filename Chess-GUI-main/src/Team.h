@@ -6,26 +6,23 @@
 #include <memory>
 #include <string>
 #include "raylib.h"
+#include "Board.h"
 #include "Piece.h"
 using namespace std;
 class Team {
 private:
     bool isWhite;
-     vector< unique_ptr<Piece>> pieces;
+    const Board& board;
+     unique_ptr<Piece> pieces[NUM_PIECE_TYPES];
 
 public:
-    Team(bool isWhiteTeam);
+    Team(const Board& gameBoard, bool isWhiteTeam);
     ~Team();
 
-    const  vector< unique_ptr<Piece>>& GetPieces() const { return pieces; }
-    Piece* FindPieceAt(int x, int y);
-    void RemovePieceAt(int x, int y);
-    void AddPiece(PieceType type, int x, int y);  
-    void Reset();  
-
-private:
-    void SetupPieces();
-    void AddPiece(int x, int y, char type);  
+    Bitboard GetPieces() const { return board.GetSide(isWhite); }
+    const Piece* GetPiece(PieceType type) const { return pieces[(int)type].get(); }
+    int GetKingSquare() const { return board.GetKingSquare(isWhite); }
+    const Piece* FindPieceAt(int x, int y) const;
 };
 
 #endif
@@ -8,13 +8,61 @@
 #include "Bishop.h"
 #include "Knight.h"
 #include "Rook.h"
+#include "Nnue.h"
+#include "Uci.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 static const int TILE_SIZE = 80;
 static const int BOARD_SIZE = 8;
-int main() {
+int main(int argc, char* argv[]) {
+    // UCI mode is for chess GUIs and tournament managers: it speaks the
+    // protocol on stdin and stdout and never opens a window.
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--uci") == 0) {
+            return RunUci(std::cin, std::cout);
+        }
+    }
+
+    // The computer opponent thinks for one second per move unless told otherwise.
+    SearchLimits engineLimits;
+    engineLimits.moveTimeMs = 1000;
+    int engineThreads = 1;
+    int engineHashMb = 16;
+    int64_t engineSliceUs = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--movetime") == 0) {
+            engineLimits.moveTimeMs = atoll(argv[i + 1]);
+        } else if (strcmp(argv[i], "--nodes") == 0) {
+            engineLimits.nodes = strtoull(argv[i + 1], nullptr, 10);
+            engineLimits.moveTimeMs = 0;
+        } else if (strcmp(argv[i], "--depth") == 0) {
+            engineLimits.depth = atoi(argv[i + 1]);
+            engineLimits.moveTimeMs = 0;
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            engineThreads = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--hash") == 0) {
+            engineHashMb = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--slice") == 0) {
+            engineSliceUs = atoll(argv[i + 1]);
+        } else if (strcmp(argv[i], "--nnue") == 0) {
+            // Without a usable weights file the classical evaluation stays in place.
+            if (!LoadNetwork(argv[i + 1])) {
+                fprintf(stderr, "Could not load network %s, using the classical evaluation\n", argv[i + 1]);
+            }
+        }
+    }
+
     InitWindow(1920,1080, "Chess with Raylib");
     SetTargetFPS(60);
     Game chessGame;
+    chessGame.SetEngineLimits(engineLimits);
+    chessGame.SetEngineThreads(engineThreads);
+    chessGame.SetEngineTimeSlice(engineSliceUs);
+    if (!chessGame.SetEngineHashSize(engineHashMb)) {
+        fprintf(stderr, "Could not allocate a %d MB hash, keeping the default size\n", engineHashMb);
+    }
     chessGame.Run();
     return 0;
 }
@@ -0,0 +1,523 @@
+#include "Board.h"
+#include "Engine.h"
+#include "Evaluate.h"
+#include "Nnue.h"
+#include "Rules.h"
+#include "See.h"
+#include "SlicedSearch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+struct BenchPosition {
+    const char* name;
+    const char* fen;
+};
+
+static const vector<BenchPosition> BENCH_POSITIONS = {
+    {"start", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"},
+    {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"},
+    {"italian", "r1bqk2r/pppp1ppp/2n2n2/2b1p3/2B1P3/3P1N2/PPP2PPP/RNBQK2R w KQkq - 1 5"},
+    {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"},
+    {"endgame", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"},
+};
+
+// Searches every bench position to a fixed depth with 1, 2, 4, ... threads
+// and reports the time to reach that depth next to the combined node rate.
+static int RunSmp(int maxThreads, int depth)
+{
+    vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    double baseSeconds = 0;
+    printf("threads  depth  %14s  %10s  %12s  %8s\n", "nodes", "time (s)", "nps", "speedup");
+
+    for (int threads : threadCounts)
+    {
+        Engine engine;
+        engine.SetThreads(threads);
+
+        uint64_t nodes = 0;
+        double seconds = 0;
+        for (const auto& position : BENCH_POSITIONS)
+        {
+            Board board;
+            board.SetFen(position.fen);
+            engine.NewGame();
+
+            SearchLimits limits;
+            limits.depth = depth;
+            SearchResult result = engine.SearchBlocking(board, PositionHistory(), limits);
+            nodes += result.nodes;
+            seconds += result.timeMs / 1000.0;
+        }
+
+        if (threads == 1)
+            baseSeconds = seconds;
+        printf("%7d  %5d  %14llu  %10.3f  %12.0f  %7.2fx\n", threads, depth, (unsigned long long)nodes, seconds,
+            seconds > 0 ? nodes / seconds : 0.0, seconds > 0 ? baseSeconds / seconds : 0.0);
+    }
+    return 0;
+}
+
+// Searches each bench position with a fresh table of the given size and
+// reports how well the table served the search.
+static int RunTable(size_t megabytes, int depth, int threads)
+{
+    Engine engine;
+    engine.SetThreads(threads);
+    if (!engine.SetHashSize(megabytes))
+    {
+        fprintf(stderr, "Cannot allocate a %zu MB table\n", megabytes);
+        return 1;
+    }
+    printf("table %zu MB, %d thread(s), depth %d\n\n", engine.GetHashSizeBytes() >> 20, threads, depth);
+    printf("%-10s  %12s  %12s  %8s  %8s  %12s  %9s\n", "position", "nodes", "probes", "hit rate", "fill", "collisions",
+        "pawn hits");
+
+    TTStats total;
+    PawnTableStats pawnTotal;
+    for (const auto& position : BENCH_POSITIONS)
+    {
+        Board board;
+        board.SetFen(position.fen);
+        engine.NewGame();
+
+        SearchLimits limits;
+        limits.depth = depth;
+        SearchResult result = engine.SearchBlocking(board, PositionHistory(), limits);
+        const TTStats& stats = result.tableStats;
+        total += stats;
+        pawnTotal += result.pawnStats;
+
+        printf("%-10s  %12llu  %12llu  %7.1f%%  %7.1f%%  %12llu  %8.1f%%\n", position.name, (unsigned long long)result.nodes,
+            (unsigned long long)stats.probes, stats.GetHitRate() * 100, engine.GetHashFillPermille() / 10.0,
+            (unsigned long long)stats.collisions, result.pawnStats.GetHitRate() * 100);
+    }
+
+    printf("\ntotal hit rate %.1f%%, %llu stores, %llu collisions\n", total.GetHitRate() * 100,
+        (unsigned long long)total.stores, (unsigned long long)total.collisions);
+    printf("pawn table hit rate %.1f%% over %llu probes\n", pawnTotal.GetHitRate() * 100,
+        (unsigned long long)pawnTotal.probes);
+    return 0;
+}
+
+// Searches every bench position to a fixed depth with the staged move
+// picker and again in plain generator order, and reports the nodes saved.
+static int RunOrdering(int depth)
+{
+    printf("%-10s  %14s  %14s  %9s\n", "position", "unordered", "ordered", "reduction");
+
+    uint64_t totals[2] = {0, 0};
+    for (const auto& position : BENCH_POSITIONS)
+    {
+        Board board;
+        board.SetFen(position.fen);
+
+        uint64_t nodes[2];
+        for (int ordered = 0; ordered < 2; ordered++)
+        {
+            Engine engine;
+            SearchOptions options;
+            options.moveOrdering = ordered == 1;
+            engine.SetOptions(options);
+
+            SearchLimits limits;
+            limits.depth = depth;
+            nodes[ordered] = engine.SearchBlocking(board, PositionHistory(), limits).nodes;
+            totals[ordered] += nodes[ordered];
+        }
+
+        printf("%-10s  %14llu  %14llu  %8.1f%%\n", position.name, (unsigned long long)nodes[0],
+            (unsigned long long)nodes[1], 100.0 * (1.0 - (double)nodes[1] / nodes[0]));
+    }
+
+    printf("\n%-10s  %14llu  %14llu  %8.1f%%\n", "total", (unsigned long long)totals[0],
+        (unsigned long long)totals[1], 100.0 * (1.0 - (double)totals[1] / totals[0]));
+    return 0;
+}
+
+struct SelectivityConfig {
+    const char* name;
+    SearchOptions options;
+};
+
+static SearchOptions PlainOptions()
+{
+    SearchOptions options;
+    options.quiescence = false;
+    options.nullMove = false;
+    options.lateMoveReductions = false;
+    options.futility = false;
+    options.razoring = false;
+    return options;
+}
+
+// Gives each bench position the same time with the selective features off,
+// each one on by itself, and all of them on, and reports the depth reached
+// and nodes searched.
+static int RunSelectivity(int64_t moveTimeMs)
+{
+    vector<SelectivityConfig> configs(6, SelectivityConfig{"", PlainOptions()});
+    configs[0].name = "plain";
+    configs[1].name = "quiescence";
+    configs[1].options.quiescence = true;
+    configs[2].name = "null move";
+    configs[2].options.nullMove = true;
+    configs[3].name = "lmr";
+    configs[3].options.lateMoveReductions = true;
+    configs[4].name = "futility";
+    configs[4].options.futility = true;
+    configs[4].options.razoring = true;
+    configs[5].name = "all";
+    configs[5].options = SearchOptions();
+
+    printf("%lld ms per position, depth reached\n\n%-12s", (long long)moveTimeMs, "");
+    for (const auto& position : BENCH_POSITIONS)
+        printf("  %9s", position.name);
+    printf("  %12s\n", "nodes");
+
+    for (const auto& config : configs)
+    {
+        printf("%-12s", config.name);
+        uint64_t nodes = 0;
+        for (const auto& position : BENCH_POSITIONS)
+        {
+            Board board;
+            board.SetFen(position.fen);
+            Engine engine;
+            engine.SetOptions(config.options);
+
+            SearchLimits limits;
+            limits.moveTimeMs = moveTimeMs;
+            SearchResult result = engine.SearchBlocking(board, PositionHistory(), limits);
+            nodes += result.nodes;
+            printf("  %9d", result.depth);
+            fflush(stdout);
+        }
+        printf("  %12llu\n", (unsigned long long)nodes);
+    }
+    return 0;
+}
+
+// Keeps the timed loops from being optimised away.
+static volatile long long benchSink;
+
+// Random games from every bench position, as the boards and the moves
+// between them, for timing evaluators on realistic material.
+static void CollectGames(int plies, vector<Board>& boards, vector<BoardMove>& moves)
+{
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    for (int game = 0; (int)boards.size() < plies; game++)
+    {
+        Board board;
+        board.SetFen(BENCH_POSITIONS[game % BENCH_POSITIONS.size()].fen);
+        for (int ply = 0; ply < 120; ply++)
+        {
+            MoveList legal;
+            GenerateLegalMoves(board, legal);
+            if (legal.IsEmpty())
+                break;
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            BoardMove move = legal[(int)((seed >> 33) % legal.Size())];
+            boards.push_back(board);
+            moves.push_back(move);
+            board = board.Apply(move);
+        }
+        moves.back() = BoardMove();
+    }
+}
+
+// Evaluations per second of the classical evaluator and of the network,
+// both refreshed from scratch and updated incrementally along each game.
+// Without a weights file the network is random, which times the same.
+static int RunEval(const string& path, int plies)
+{
+    unique_ptr<Network> network(new Network());
+    if (path.empty())
+        network->Randomize(1);
+    else if (!network->Load(path))
+    {
+        fprintf(stderr, "Cannot load network %s\n", path.c_str());
+        return 1;
+    }
+
+    vector<Board> boards;
+    vector<BoardMove> moves;
+    CollectGames(plies, boards, moves);
+    printf("%d positions, network %s, kernels %s\n\n", (int)boards.size(),
+        path.empty() ? "random" : path.c_str(), GetSimdName());
+    printf("%-20s  %14s  %8s\n", "evaluator", "evals/sec", "relative");
+
+    long long checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (const Board& board : boards)
+        checksum += EvaluateClassical(board);
+    double classical = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (const Board& board : boards)
+        checksum += network->Evaluate(board);
+    double refreshed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // A null move marks the end of a game; the next board starts a new one.
+    unique_ptr<Accumulator[]> accumulators(new Accumulator[2]);
+    bool fresh = true;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < boards.size(); i++)
+    {
+        Accumulator& current = accumulators[i & 1];
+        if (fresh)
+            network->Refresh(boards[i], current);
+        checksum += network->Evaluate(current, boards[i].IsWhiteToMove());
+        fresh = moves[i].IsNull();
+        if (!fresh)
+            network->Update(boards[i], moves[i], current, accumulators[(i + 1) & 1]);
+    }
+    double incremental = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    benchSink = checksum;
+
+    double count = (double)boards.size();
+    printf("%-20s  %14.0f  %7.2fx\n", "classical", count / classical, 1.0);
+    printf("%-20s  %14.0f  %7.2fx\n", "network, refreshed", count / refreshed, classical / refreshed);
+    printf("%-20s  %14.0f  %7.2fx\n", "network, updated", count / incremental, classical / incremental);
+    return 0;
+}
+
+static bool ReadFile(const string& path, vector<char>& bytes)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+    bytes.clear();
+    char buffer[65536];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        bytes.insert(bytes.end(), buffer, buffer + count);
+    fclose(file);
+    return true;
+}
+
+static bool WriteFile(const string& path, const vector<char>& bytes)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+    bool ok = bytes.empty() || fwrite(bytes.data(), bytes.size(), 1, file) == 1;
+    return fclose(file) == 0 && ok;
+}
+
+// Loads a random network into the engine, then feeds LoadNetwork broken
+// copies of its file. Each must be refused and leave the loaded weights
+// exactly as they were, both as saved bytes and as evaluations.
+static int RunLoad(const string& path)
+{
+    string broken = path + ".bad";
+    string saved = path + ".saved";
+    unique_ptr<Network> random(new Network());
+    random->Randomize(7);
+    vector<char> good;
+    if (!random->Save(path) || !ReadFile(path, good) || !LoadNetwork(path))
+    {
+        fprintf(stderr, "Cannot write and load network %s\n", path.c_str());
+        return 1;
+    }
+
+    vector<int> evals;
+    for (const auto& position : BENCH_POSITIONS)
+    {
+        Board board;
+        board.SetFen(position.fen);
+        evals.push_back(GetNetwork().Evaluate(board));
+    }
+
+    struct BrokenFile {
+        const char* name;
+        vector<char> bytes;
+    };
+    vector<BrokenFile> cases = {
+        {"empty", {}},
+        {"short header", vector<char>(good.begin(), good.begin() + 6)},
+        {"bad magic", good},
+        {"half weights", vector<char>(good.begin(), good.begin() + good.size() / 2)},
+        {"no output bias", vector<char>(good.begin(), good.end() - 4)},
+        {"trailing byte", good},
+    };
+    cases[2].bytes[0] ^= 1;
+    cases[5].bytes.push_back(0);
+
+    int failed = 0;
+    for (const auto& test : cases)
+    {
+        bool refused = WriteFile(broken, test.bytes) && !LoadNetwork(broken);
+        vector<char> after;
+        bool unchanged = IsNetworkLoaded() && GetNetwork().Save(saved) && ReadFile(saved, after) && after == good;
+        for (size_t i = 0; unchanged && i < BENCH_POSITIONS.size(); i++)
+        {
+            Board board;
+            board.SetFen(BENCH_POSITIONS[i].fen);
+            unchanged = GetNetwork().Evaluate(board) == evals[i];
+        }
+        bool ok = refused && unchanged;
+        failed += ok ? 0 : 1;
+        printf("%-16s  %8zu bytes  %-7s  %s\n", test.name, test.bytes.size(), refused ? "refused" : "LOADED",
+            ok ? "ok" : "FAIL");
+    }
+
+    remove(path.c_str());
+    remove(broken.c_str());
+    remove(saved.c_str());
+    printf("\n%d of %zu broken files failed\n", failed, cases.size());
+    return failed == 0 ? 0 : 1;
+}
+
+// Times static exchange evaluation: every capture in each bench position,
+// and the full-board hanging-piece scan the GUI overlay runs.
+static int RunSee(int iterations)
+{
+    printf("%-10s  %8s  %14s  %14s\n", "position", "captures", "ns per capture", "us per scan");
+
+    for (const auto& position : BENCH_POSITIONS)
+    {
+        Board board;
+        board.SetFen(position.fen);
+        MoveList moves;
+        GenerateLegalMoves(board, moves);
+        MoveList captures;
+        for (const auto& move : moves)
+        {
+            if (move.IsCapture())
+                captures.Add(move);
+        }
+
+        long long checksum = 0;
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            for (const auto& move : captures)
+                checksum += See(board, move);
+        }
+        double captureSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+            checksum += PopCount(GetHangingPieces(board, true) | GetHangingPieces(board, false));
+        double scanSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        double perCapture = captures.IsEmpty() ? 0.0 : captureSeconds * 1e9 / ((double)iterations * captures.Size());
+        benchSink = checksum;
+        printf("%-10s  %8d  %14.1f  %14.2f\n", position.name, captures.Size(), perCapture, scanSeconds * 1e6 / iterations);
+    }
+    return 0;
+}
+
+// Drives a sliced search the way the game loop does, one step per frame,
+// and reports how long the steps really took against the budget, next to
+// the depth the search reached on each position.
+static int RunSlices(int64_t sliceUs, int moveTimeMs)
+{
+    printf("slice %lld us, %d ms per move\n\n", (long long)sliceUs, moveTimeMs);
+    printf("%-10s  %6s  %5s  %12s  %10s  %10s  %10s\n", "position", "steps", "depth", "nodes", "mean (us)",
+        "p99 (us)", "max (us)");
+
+    SlicedSearch search;
+    search.SetHashSize(16);
+    vector<double> all;
+    for (const auto& position : BENCH_POSITIONS)
+    {
+        Board board;
+        board.SetFen(position.fen);
+        search.NewGame();
+
+        SearchLimits limits;
+        limits.moveTimeMs = moveTimeMs;
+        search.Start(board, PositionHistory(), limits);
+
+        vector<double> steps;
+        while (!search.HasResult())
+        {
+            auto start = chrono::steady_clock::now();
+            search.Step(sliceUs);
+            steps.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+        }
+        SearchResult result = search.TakeResult();
+        all.insert(all.end(), steps.begin(), steps.end());
+
+        double total = 0;
+        for (double step : steps)
+            total += step;
+        sort(steps.begin(), steps.end());
+        printf("%-10s  %6zu  %5d  %12llu  %10.0f  %10.0f  %10.0f\n", position.name, steps.size(), result.depth,
+            (unsigned long long)result.nodes, total / steps.size(), steps[steps.size() * 99 / 100], steps.back());
+    }
+
+    sort(all.begin(), all.end());
+    printf("\nall steps: p99 %.0f us, max %.0f us\n", all[all.size() * 99 / 100], all.back());
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    string mode = argc > 1 ? argv[1] : "";
+    if (mode == "smp")
+    {
+        int maxThreads = argc > 2 ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+        int depth = argc > 3 ? atoi(argv[3]) : 7;
+        return RunSmp(maxThreads > 0 ? maxThreads : 1, depth > 0 ? depth : 7);
+    }
+    if (mode == "tt")
+    {
+        int megabytes = argc > 2 ? atoi(argv[2]) : 16;
+        int depth = argc > 3 ? atoi(argv[3]) : 7;
+        int threads = argc > 4 ? atoi(argv[4]) : 1;
+        return RunTable(megabytes > 0 ? megabytes : 16, depth > 0 ? depth : 7, threads > 0 ? threads : 1);
+    }
+
+    if (mode == "order")
+    {
+        int depth = argc > 2 ? atoi(argv[2]) : 5;
+        return RunOrdering(depth > 0 ? depth : 5);
+    }
+    if (mode == "select")
+    {
+        int moveTimeMs = argc > 2 ? atoi(argv[2]) : 1000;
+        return RunSelectivity(moveTimeMs > 0 ? moveTimeMs : 1000);
+    }
+    if (mode == "eval")
+    {
+        string path = argc > 2 ? argv[2] : "";
+        int plies = argc > 3 ? atoi(argv[3]) : 200000;
+        return RunEval(path, plies > 0 ? plies : 200000);
+    }
+    if (mode == "load")
+        return RunLoad(argc > 2 ? argv[2] : "bench.nnue");
+    if (mode == "see")
+    {
+        int iterations = argc > 2 ? atoi(argv[2]) : 100000;
+        return RunSee(iterations > 0 ? iterations : 100000);
+    }
+    if (mode == "slice")
+    {
+        int64_t sliceUs = argc > 2 ? atoll(argv[2]) : 8000;
+        int moveTimeMs = argc > 3 ? atoi(argv[3]) : 1000;
+        return RunSlices(sliceUs > 0 ? sliceUs : 8000, moveTimeMs > 0 ? moveTimeMs : 1000);
+    }
+
+    fprintf(stderr, "Usage: bench smp [threads] [depth]         time to depth and nps for 1, 2, 4 ... threads\n");
+    fprintf(stderr, "       bench tt [mb] [depth] [threads]     transposition and pawn table hit rates, fill and collisions\n");
+    fprintf(stderr, "       bench order [depth]                 nodes to depth with and without move ordering\n");
+    fprintf(stderr, "       bench select [ms]                   depth and nodes in fixed time per selective feature\n");
+    fprintf(stderr, "       bench eval [weights] [positions]    evals/sec of the network against the classical evaluator\n");
+    fprintf(stderr, "       bench load [file]                   broken weights files leave the loaded network unchanged\n");
+    fprintf(stderr, "       bench see [iterations]              static exchange and hanging-piece scan timings\n");
+    fprintf(stderr, "       bench slice [us] [ms]               step times of a search sliced into frames\n");
+    return 1;
+}
@@ -0,0 +1,202 @@
+#include "Board.h"
+#include "Perft.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+struct ReferencePosition {
+    const char* name;
+    const char* fen;
+    vector<uint64_t> counts;
+};
+
+// Expected node counts by depth, starting at depth 1.
+static const vector<ReferencePosition> REFERENCE_POSITIONS = {
+    {"start", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        {20, 400, 8902, 197281, 4865609, 119060324}},
+    {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        {48, 2039, 97862, 4085603, 193690690}},
+    {"position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        {14, 191, 2812, 43238, 674624, 11030083}},
+    {"position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        {6, 264, 9467, 422333, 15833292}},
+    {"position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        {44, 1486, 62379, 2103487, 89941194}},
+    {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        {46, 2079, 89890, 3894594, 164075551}},
+};
+
+static int threadCount = max(1, (int)thread::hardware_concurrency());
+static int splitDepth = 2;
+
+static double SecondsSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static int RunSuite(int maxDepth)
+{
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0;
+    int failures = 0;
+
+    for (const auto& position : REFERENCE_POSITIONS)
+    {
+        Board board;
+        board.SetFen(position.fen);
+
+        int depth = min(maxDepth, (int)position.counts.size());
+        uint64_t expected = position.counts[depth - 1];
+
+        auto start = chrono::steady_clock::now();
+        uint64_t nodes = ParallelPerft(board, depth, threadCount, splitDepth);
+        double seconds = SecondsSince(start);
+
+        bool passed = nodes == expected;
+        failures += passed ? 0 : 1;
+        totalNodes += nodes;
+        totalSeconds += seconds;
+
+        printf("%-10s depth %d  %12llu nodes  %8.3f s  %12.0f nps  %s\n",
+            position.name, depth, (unsigned long long)nodes, seconds,
+            seconds > 0 ? nodes / seconds : 0.0, passed ? "ok" : "FAIL");
+        if (!passed)
+            printf("           expected %llu\n", (unsigned long long)expected);
+    }
+
+    printf("\ntotal      %12llu nodes  %8.3f s  %12.0f nps\n",
+        (unsigned long long)totalNodes, totalSeconds, totalSeconds > 0 ? totalNodes / totalSeconds : 0.0);
+    printf("%d of %d positions failed\n", failures, (int)REFERENCE_POSITIONS.size());
+    return failures == 0 ? 0 : 1;
+}
+
+static int RunDivide(int depth, const string& fen)
+{
+    Board board;
+    if (!board.SetFen(fen))
+    {
+        fprintf(stderr, "Invalid FEN: %s\n", fen.c_str());
+        return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    vector<PerftDivide> divide = ParallelPerftDivided(board, depth, threadCount, splitDepth);
+    double seconds = SecondsSince(start);
+
+    uint64_t nodes = 0;
+    for (const auto& entry : divide)
+    {
+        printf("%s: %llu\n", MoveToString(entry.move).c_str(), (unsigned long long)entry.nodes);
+        nodes += entry.nodes;
+    }
+
+    printf("\nMoves: %d\nNodes: %llu\nTime: %.3f s\nNPS: %.0f\n",
+        (int)divide.size(), (unsigned long long)nodes, seconds, seconds > 0 ? nodes / seconds : 0.0);
+    return 0;
+}
+
+// Runs the whole suite at one depth with 1, 2, 4 ... threads up to the
+// configured count, checking every parallel total against the
+// single-threaded one.
+static int RunScaling(int maxDepth)
+{
+    vector<int> threadCounts;
+    for (int threads = 1; threads < threadCount; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(threadCount);
+
+    vector<uint64_t> reference;
+    double baseSeconds = 0;
+    int failures = 0;
+    printf("threads  %14s  %10s  %14s  %8s\n", "nodes", "time (s)", "nps", "speedup");
+
+    for (int threads : threadCounts)
+    {
+        uint64_t totalNodes = 0;
+        double seconds = 0;
+        for (size_t i = 0; i < REFERENCE_POSITIONS.size(); i++)
+        {
+            Board board;
+            board.SetFen(REFERENCE_POSITIONS[i].fen);
+            int depth = min(maxDepth, (int)REFERENCE_POSITIONS[i].counts.size());
+
+            auto start = chrono::steady_clock::now();
+            uint64_t nodes = threads == 1 ? Perft(board, depth) : ParallelPerft(board, depth, threads, splitDepth);
+            seconds += SecondsSince(start);
+
+            if (threads == 1)
+                reference.push_back(nodes);
+            else if (nodes != reference[i])
+            {
+                failures++;
+                printf("%s: %llu nodes with %d threads, %llu with one\n", REFERENCE_POSITIONS[i].name,
+                    (unsigned long long)nodes, threads, (unsigned long long)reference[i]);
+            }
+            totalNodes += nodes;
+        }
+
+        if (threads == 1)
+            baseSeconds = seconds;
+        printf("%7d  %14llu  %10.3f  %14.0f  %7.2fx\n", threads, (unsigned long long)totalNodes, seconds,
+            seconds > 0 ? totalNodes / seconds : 0.0, seconds > 0 ? baseSeconds / seconds : 0.0);
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+    vector<string> args;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+        {
+            threadCount = atoi(argv[++i]);
+            if (threadCount < 1)
+                threadCount = max(1, (int)thread::hardware_concurrency());
+        }
+        else if (arg == "--split" && i + 1 < argc)
+            splitDepth = atoi(argv[++i]);
+        else
+            args.push_back(arg);
+    }
+
+    if (args.empty())
+        return RunSuite(4);
+
+    bool suite = args[0] == "--suite";
+    bool scaling = args[0] == "--scaling";
+    int depth = atoi(args[0].c_str());
+    if (suite || scaling)
+        depth = args.size() > 1 ? atoi(args[1].c_str()) : (suite ? 4 : 5);
+
+    // Zero, negative and non-numeric depths get the usage text.
+    if (depth < 1)
+    {
+        fprintf(stderr, "Usage: perft [options]                     run the reference suite to depth 4\n");
+        fprintf(stderr, "       perft [options] --suite <depth>     run the reference suite to <depth>\n");
+        fprintf(stderr, "       perft [options] --scaling <depth>   suite wall time for 1, 2, 4 ... threads\n");
+        fprintf(stderr, "       perft [options] <depth> [fen]       divide counts for one position\n");
+        fprintf(stderr, "Options: --threads <n>   worker threads, 0 for one per core (the default)\n");
+        fprintf(stderr, "         --split <plies> depth at which the tree is cut into tasks (default 2)\n");
+        return 1;
+    }
+    if (suite)
+        return RunSuite(depth);
+    if (scaling)
+        return RunScaling(depth);
+
+    string fen = REFERENCE_POSITIONS[0].fen;
+    if (args.size() > 1)
+    {
+        fen = args[1];
+        for (size_t i = 2; i < args.size(); i++)
+            fen += " " + args[i];
+    }
+    return RunDivide(depth, fen);
+}
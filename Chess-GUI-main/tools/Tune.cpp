@@ -0,0 +1,436 @@
+#include "Board.h"
+#include "Evaluate.h"
+#include "PieceSquare.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// The classical evaluation is linear in its weights once the phase is
+// fixed, so a position reduces to a list of (term, count) features, white
+// minus black. Every term has a middlegame and an endgame weight.
+const int MATERIAL_TERMS = 0;
+const int SQUARE_TERMS = MATERIAL_TERMS + NUM_PIECE_TYPES;
+const int PASSED_TERMS = SQUARE_TERMS + NUM_PIECE_TYPES * NUM_SQUARES;
+const int DOUBLED_TERM = PASSED_TERMS + 8;
+const int ISOLATED_TERM = DOUBLED_TERM + 1;
+const int NUM_TERMS = ISOLATED_TERM + 1;
+
+struct Feature {
+    int term;
+    int count;
+};
+
+struct Sample {
+    vector<Feature> features;
+    double phase;
+    double result;
+};
+
+struct TuneOptions {
+    string inputPath;
+    string outputPath = "tuned_weights.txt";
+    int threads = 0;
+    int epochs = 10;
+    size_t batchSize = 16384;
+    double rate = 1.0;
+    double k = 1.0;
+};
+
+// Loss and gradient summed by one worker over its share of a batch. Each
+// worker writes only its own, on its own cache lines, and the main thread
+// adds them up once the batch is done.
+struct alignas(64) PartialSums {
+    vector<double> gradient;
+    double loss = 0;
+    uint64_t positions = 0;
+    uint64_t skipped = 0;
+    uint64_t mismatches = 0;
+
+    void Reset()
+    {
+        gradient.assign(NUM_TERMS * 2, 0.0);
+        loss = 0;
+        positions = 0;
+        skipped = 0;
+        mismatches = 0;
+    }
+};
+
+static TuneOptions options;
+static vector<double> engineWeights;
+
+static double SecondsSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Starts from the weights the engine is built with.
+static vector<double> GetEngineWeights()
+{
+    vector<double> weights(NUM_TERMS * 2);
+    for (int type = 0; type < NUM_PIECE_TYPES; type++)
+    {
+        weights[(MATERIAL_TERMS + type) * 2] = MIDGAME_MATERIAL[type];
+        weights[(MATERIAL_TERMS + type) * 2 + 1] = ENDGAME_MATERIAL[type];
+        for (int square = 0; square < NUM_SQUARES; square++)
+        {
+            int term = SQUARE_TERMS + type * NUM_SQUARES + square;
+            weights[term * 2] = MIDGAME_SQUARES[type][square];
+            weights[term * 2 + 1] = ENDGAME_SQUARES[type][square];
+        }
+    }
+    for (int rank = 0; rank < 8; rank++)
+    {
+        weights[(PASSED_TERMS + rank) * 2] = PASSED_MIDGAME[rank];
+        weights[(PASSED_TERMS + rank) * 2 + 1] = PASSED_ENDGAME[rank];
+    }
+    weights[DOUBLED_TERM * 2] = DOUBLED_MIDGAME;
+    weights[DOUBLED_TERM * 2 + 1] = DOUBLED_ENDGAME;
+    weights[ISOLATED_TERM * 2] = ISOLATED_MIDGAME;
+    weights[ISOLATED_TERM * 2 + 1] = ISOLATED_ENDGAME;
+    return weights;
+}
+
+// Accepts "<fen> [1.0]", "<fen> 0.5" and EPD-style "<fen> c9 \"1-0\";"
+// lines, with the result from white's point of view.
+static bool ParseLine(const string& line, Board& board, double& result)
+{
+    istringstream stream(line);
+    vector<string> tokens;
+    string token;
+    while (stream >> token)
+        tokens.push_back(token);
+    if (tokens.size() < 5)
+        return false;
+
+    string label;
+    for (char c : tokens.back())
+    {
+        if (c != '[' && c != ']' && c != '"' && c != ';')
+            label += c;
+    }
+    if (label == "1-0")
+        result = 1.0;
+    else if (label == "0-1")
+        result = 0.0;
+    else if (label == "1/2-1/2")
+        result = 0.5;
+    else
+    {
+        char* end = nullptr;
+        result = strtod(label.c_str(), &end);
+        if (label.empty() || *end != '\0' || result < 0.0 || result > 1.0)
+            return false;
+    }
+
+    // Board, side, castling and en passant, then the two clocks if present.
+    string fen = tokens[0] + " " + tokens[1] + " " + tokens[2] + " " + tokens[3];
+    size_t fields = 4;
+    while (fields < 6 && fields + 1 < tokens.size() && tokens[fields].find_first_not_of("0123456789") == string::npos)
+        fen += " " + tokens[fields++];
+    return board.SetFen(fen);
+}
+
+static void ExtractFeatures(const Board& board, Sample& sample)
+{
+    sample.features.clear();
+    for (int square = 0; square < NUM_SQUARES; square++)
+    {
+        if (board.IsEmpty(square))
+            continue;
+        int type = (int)board.GetTypeAt(square);
+        bool isWhite = board.IsWhiteAt(square);
+        int sign = isWhite ? 1 : -1;
+        sample.features.push_back({MATERIAL_TERMS + type, sign});
+        sample.features.push_back({SQUARE_TERMS + type * NUM_SQUARES + (isWhite ? square : square ^ 56), sign});
+    }
+
+    PawnFeatures white = CountPawnFeatures(board, true);
+    PawnFeatures black = CountPawnFeatures(board, false);
+    for (int rank = 0; rank < 8; rank++)
+    {
+        if (white.passed[rank] != black.passed[rank])
+            sample.features.push_back({PASSED_TERMS + rank, white.passed[rank] - black.passed[rank]});
+    }
+    if (white.doubled != black.doubled)
+        sample.features.push_back({DOUBLED_TERM, white.doubled - black.doubled});
+    if (white.isolated != black.isolated)
+        sample.features.push_back({ISOLATED_TERM, white.isolated - black.isolated});
+
+    int phase = board.GetPhase() < MAX_PHASE ? board.GetPhase() : MAX_PHASE;
+    sample.phase = (double)phase / MAX_PHASE;
+}
+
+// White's score under the given weights, tapered the same way as
+// EvaluateClassical.
+static double EvaluateSample(const Sample& sample, const vector<double>& weights)
+{
+    double midgame = 0;
+    double endgame = 0;
+    for (const Feature& feature : sample.features)
+    {
+        midgame += feature.count * weights[feature.term * 2];
+        endgame += feature.count * weights[feature.term * 2 + 1];
+    }
+    return midgame * sample.phase + endgame * (1.0 - sample.phase);
+}
+
+static double Sigmoid(double score)
+{
+    return 1.0 / (1.0 + pow(10.0, -options.k * score / 400.0));
+}
+
+// Squared error between the game result and the win probability the score
+// predicts. On the first epoch every position is also scored with the
+// starting weights and checked against the engine's own evaluator, so the
+// features cannot drift from it unnoticed.
+static void ProcessLines(const vector<string>& lines, size_t begin, size_t end, const vector<double>& weights,
+    bool checkEngine, PartialSums& sums)
+{
+    Board board;
+    Sample sample;
+    const double slope = options.k * log(10.0) / 400.0;
+
+    for (size_t i = begin; i < end; i++)
+    {
+        if (!ParseLine(lines[i], board, sample.result))
+        {
+            sums.skipped++;
+            continue;
+        }
+        ExtractFeatures(board, sample);
+
+        double score = EvaluateSample(sample, weights);
+        if (checkEngine)
+        {
+            int engineScore = EvaluateClassical(board);
+            if (!board.IsWhiteToMove())
+                engineScore = -engineScore;
+            if (fabs(EvaluateSample(sample, engineWeights) - engineScore) >= 1.0)
+                sums.mismatches++;
+        }
+
+        double predicted = Sigmoid(score);
+        double error = sample.result - predicted;
+        sums.loss += error * error;
+        sums.positions++;
+
+        double scale = -2.0 * error * predicted * (1.0 - predicted) * slope;
+        for (const Feature& feature : sample.features)
+        {
+            sums.gradient[feature.term * 2] += scale * feature.count * sample.phase;
+            sums.gradient[feature.term * 2 + 1] += scale * feature.count * (1.0 - sample.phase);
+        }
+    }
+}
+
+static void WriteArray(FILE* file, const char* declaration, const vector<double>& weights, int firstTerm, int count,
+    int phase)
+{
+    fprintf(file, "%s = {", declaration);
+    for (int i = 0; i < count; i++)
+        fprintf(file, "%s%d", i ? ", " : "", (int)lround(weights[(firstTerm + i) * 2 + phase]));
+    fprintf(file, "};\n");
+}
+
+static void WriteSquares(FILE* file, const char* declaration, const vector<double>& weights, int phase)
+{
+    fprintf(file, "%s = {\n", declaration);
+    for (int type = 0; type < NUM_PIECE_TYPES; type++)
+    {
+        for (int square = 0; square < NUM_SQUARES; square++)
+        {
+            int term = SQUARE_TERMS + type * NUM_SQUARES + square;
+            const char* prefix = square == 0 ? "    {" : (square % 8 == 0 ? "     " : "");
+            fprintf(file, "%s%4d%s", prefix, (int)lround(weights[term * 2 + phase]),
+                square == NUM_SQUARES - 1 ? "},\n" : (square % 8 == 7 ? ",\n" : ","));
+        }
+    }
+    fprintf(file, "};\n");
+}
+
+// Writes the weights in the form PieceSquare.h and Evaluate.h declare them,
+// so a run can be pasted straight back into the engine.
+static bool WriteWeights(const vector<double>& weights, int epoch, double loss)
+{
+    FILE* file = fopen(options.outputPath.c_str(), "w");
+    if (!file)
+        return false;
+
+    fprintf(file, "// Epoch %d, loss %.6f, k %.3f\n\n", epoch, loss, options.k);
+    WriteArray(file, "constexpr int MIDGAME_MATERIAL[NUM_PIECE_TYPES]", weights, MATERIAL_TERMS, NUM_PIECE_TYPES, 0);
+    WriteArray(file, "constexpr int ENDGAME_MATERIAL[NUM_PIECE_TYPES]", weights, MATERIAL_TERMS, NUM_PIECE_TYPES, 1);
+    fprintf(file, "\n");
+    WriteSquares(file, "constexpr int16_t MIDGAME_SQUARES[NUM_PIECE_TYPES][NUM_SQUARES]", weights, 0);
+    fprintf(file, "\n");
+    WriteSquares(file, "constexpr int16_t ENDGAME_SQUARES[NUM_PIECE_TYPES][NUM_SQUARES]", weights, 1);
+    fprintf(file, "\n");
+    WriteArray(file, "const int PASSED_MIDGAME[8]", weights, PASSED_TERMS, 8, 0);
+    WriteArray(file, "const int PASSED_ENDGAME[8]", weights, PASSED_TERMS, 8, 1);
+    fprintf(file, "const int DOUBLED_MIDGAME = %d;\n", (int)lround(weights[DOUBLED_TERM * 2]));
+    fprintf(file, "const int DOUBLED_ENDGAME = %d;\n", (int)lround(weights[DOUBLED_TERM * 2 + 1]));
+    fprintf(file, "const int ISOLATED_MIDGAME = %d;\n", (int)lround(weights[ISOLATED_TERM * 2]));
+    fprintf(file, "const int ISOLATED_ENDGAME = %d;\n", (int)lround(weights[ISOLATED_TERM * 2 + 1]));
+    fclose(file);
+    return true;
+}
+
+// Streams the file once per epoch in batches. Each batch is split into
+// slices for the pool, and the summed gradient takes one Adam step.
+static int RunTuner()
+{
+    WorkStealingPool pool(options.threads);
+    vector<PartialSums> partials(pool.GetThreadCount());
+    engineWeights = GetEngineWeights();
+    vector<double> weights = engineWeights;
+    vector<double> momentum(weights.size(), 0.0);
+    vector<double> velocity(weights.size(), 0.0);
+    const double beta1 = 0.9;
+    const double beta2 = 0.999;
+    uint64_t step = 0;
+
+    printf("tuning %d weights on %d thread(s), batch %zu, rate %.3f, k %.3f\n\n", NUM_TERMS * 2,
+        pool.GetThreadCount(), options.batchSize, options.rate, options.k);
+    printf("epoch  %10s  %12s  %10s  %12s\n", "loss", "positions", "time (s)", "pos/sec");
+
+    for (int epoch = 1; epoch <= options.epochs; epoch++)
+    {
+        ifstream input(options.inputPath);
+        if (!input)
+        {
+            fprintf(stderr, "Could not open %s\n", options.inputPath.c_str());
+            return 1;
+        }
+
+        auto start = chrono::steady_clock::now();
+        double epochLoss = 0;
+        uint64_t epochPositions = 0;
+        uint64_t skipped = 0;
+        uint64_t mismatches = 0;
+        vector<string> lines;
+        lines.reserve(options.batchSize);
+
+        while (true)
+        {
+            lines.clear();
+            string line;
+            while (lines.size() < options.batchSize && getline(input, line))
+                lines.push_back(line);
+            if (lines.empty())
+                break;
+
+            for (PartialSums& sums : partials)
+                sums.Reset();
+
+            int taskCount = (int)min(lines.size(), (size_t)pool.GetThreadCount() * 8);
+            pool.Run(taskCount, [&](int task, int worker) {
+                size_t begin = lines.size() * task / taskCount;
+                size_t end = lines.size() * (task + 1) / taskCount;
+                ProcessLines(lines, begin, end, weights, epoch == 1, partials[worker]);
+            });
+
+            vector<double> gradient(weights.size(), 0.0);
+            uint64_t positions = 0;
+            for (const PartialSums& sums : partials)
+            {
+                for (size_t i = 0; i < gradient.size(); i++)
+                    gradient[i] += sums.gradient[i];
+                epochLoss += sums.loss;
+                positions += sums.positions;
+                skipped += sums.skipped;
+                mismatches += sums.mismatches;
+            }
+            epochPositions += positions;
+            if (positions == 0)
+                continue;
+
+            step++;
+            double correction1 = 1.0 - pow(beta1, (double)step);
+            double correction2 = 1.0 - pow(beta2, (double)step);
+            for (size_t i = 0; i < weights.size(); i++)
+            {
+                double g = gradient[i] / positions;
+                momentum[i] = beta1 * momentum[i] + (1.0 - beta1) * g;
+                velocity[i] = beta2 * velocity[i] + (1.0 - beta2) * g * g;
+                weights[i] -= options.rate * (momentum[i] / correction1) / (sqrt(velocity[i] / correction2) + 1e-8);
+            }
+        }
+
+        double seconds = SecondsSince(start);
+        if (epochPositions == 0)
+        {
+            fprintf(stderr, "No labelled positions in %s\n", options.inputPath.c_str());
+            return 1;
+        }
+        if (mismatches > 0)
+        {
+            fprintf(stderr, "%llu positions scored differently from the engine's evaluator\n",
+                (unsigned long long)mismatches);
+            return 1;
+        }
+        if (epoch == 1 && skipped > 0)
+            printf("skipping %llu unreadable lines\n", (unsigned long long)skipped);
+
+        double loss = epochLoss / epochPositions;
+        printf("%5d  %10.6f  %12llu  %10.2f  %12.0f\n", epoch, loss, (unsigned long long)epochPositions, seconds,
+            seconds > 0 ? epochPositions / seconds : 0.0);
+        fflush(stdout);
+
+        if (!WriteWeights(weights, epoch, loss))
+        {
+            fprintf(stderr, "Could not write %s\n", options.outputPath.c_str());
+            return 1;
+        }
+    }
+
+    printf("\nweights written to %s\n", options.outputPath.c_str());
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    vector<string> args;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+            options.threads = atoi(argv[++i]);
+        else if (arg == "--epochs" && i + 1 < argc)
+            options.epochs = atoi(argv[++i]);
+        else if (arg == "--batch" && i + 1 < argc)
+            options.batchSize = (size_t)max(1, atoi(argv[++i]));
+        else if (arg == "--rate" && i + 1 < argc)
+            options.rate = atof(argv[++i]);
+        else if (arg == "--k" && i + 1 < argc)
+            options.k = atof(argv[++i]);
+        else if (arg == "--out" && i + 1 < argc)
+            options.outputPath = argv[++i];
+        else
+            args.push_back(arg);
+    }
+
+    if (args.size() != 1)
+    {
+        fprintf(stderr, "Usage: tune [options] <positions>   one FEN and game result per line, e.g. \"<fen> [0.5]\"\n");
+        fprintf(stderr, "Options: --threads <n>   worker threads, 0 for one per core (default 0)\n");
+        fprintf(stderr, "         --epochs <n>    passes over the file (default 10)\n");
+        fprintf(stderr, "         --batch <n>     positions per gradient step (default 16384)\n");
+        fprintf(stderr, "         --rate <r>      Adam step size in centipawns (default 1.0)\n");
+        fprintf(stderr, "         --k <k>         sigmoid scale for turning scores into results (default 1.0)\n");
+        fprintf(stderr, "         --out <file>    where to write the tuned weights (default tuned_weights.txt)\n");
+        return 1;
+    }
+
+    options.inputPath = args[0];
+    if (options.threads < 1)
+        options.threads = max(1, (int)thread::hardware_concurrency());
+    return RunTuner();
+}
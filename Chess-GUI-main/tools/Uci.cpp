@@ -0,0 +1,10 @@
+#include "Uci.h"
+#include <iostream>
+using namespace std;
+
+// The UCI engine on its own, without raylib, for tournament managers that
+// need a console program.
+int main()
+{
+    return RunUci(cin, cout);
+}